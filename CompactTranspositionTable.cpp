@@ -0,0 +1,339 @@
+#include "GamePlayer/CompactTranspositionTable.h"
+
+#include "GamePlayer/StaticEvaluator.h"
+
+#include "ParallelFor.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using json = nlohmann::json;
+
+namespace GamePlayer
+{
+
+// Largest magnitude of the code of a value that is not a win/loss. The codes beyond it encode the distance to a win/loss.
+static int constexpr MAX_VALUE_CODE = INT16_MAX - MateDistance::MAX_DISTANCE - 1;
+
+static int8_t clampQuality(int quality)
+{
+    return static_cast<int8_t>(std::clamp(quality, -127, 127));
+}
+
+//! @param  size    Number of entries in the table
+//! @param  maxAge  Maximum age of entries allowed in the table
+//! @param  sef     The static evaluator whose range of values is to be stored in the table
+
+CompactTranspositionTable::CompactTranspositionTable(size_t size, int maxAge, StaticEvaluator const & sef)
+    : table_(new Entry[std::max<size_t>(size, 1)]) // A table must have at least one entry
+    , size_(std::max<size_t>(size, 1))
+    , maxAge_(maxAge)
+    , aliceWinsValue_(sef.aliceWinsValue())
+    , bobWinsValue_(sef.bobWinsValue())
+    , mateDistance_(sef)
+{
+    assert(aliceWinsValue_ > bobWinsValue_);
+    midValue_ = (aliceWinsValue_ + bobWinsValue_) * 0.5f;
+    scale_    = MAX_VALUE_CODE / ((aliceWinsValue_ - bobWinsValue_) * 0.5f);
+
+    // Invalidate all entries in the table
+    invalidate(table_.get(), size_, 0);
+}
+
+//! @param  budget  Maximum amount of memory used by the entries
+//! @param  maxAge  Maximum age of entries allowed in the table
+//! @param  sef     The static evaluator whose range of values is to be stored in the table
+
+CompactTranspositionTable::CompactTranspositionTable(MemoryBudget budget, int maxAge, StaticEvaluator const & sef)
+    : CompactTranspositionTable(entriesInBudget(budget, sizeof(Entry)), maxAge, sef)
+{
+}
+
+//! This function returns the value of a state if the value is stored in the table. Otherwise, nothing is returned.
+//!
+//! @param  fingerprint     Fingerprint of state to be checked for
+//!
+//! @return optional CheckResult
+
+std::optional<CompactTranspositionTable::CheckResult> CompactTranspositionTable::check(uint64_t fingerprint) const
+{
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+    ++analysisData_.checkCount;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+    Entry const & entry = find(fingerprint);
+
+    if (entry.isUnused() || entry.key_ != keyOf(fingerprint))
+    {
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+        if (!entry.isUnused())
+            ++analysisData_.collisionCount;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+        // Not found
+        return std::nullopt;
+    }
+
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+    ++analysisData_.hitCount;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+    entry.age_ = 0; // Reset age
+    return CheckResult(dequantize(entry.value_), entry.q_);
+}
+
+//! This function returns the value of a state if the value is stored in the table and its quality is above the specified minimum.
+//! Otherwise, nothing is returned.
+//!
+//! @param  fingerprint     Fingerprint of state to be checked for
+//! @param  minQ            Minimum quality
+//!
+//! @return optional CheckResult
+
+std::optional<CompactTranspositionTable::CheckResult> CompactTranspositionTable::check(uint64_t fingerprint, int minQ) const
+{
+    std::optional<CheckResult> result = check(fingerprint);
+    if (result && result->second >= minQ)
+        return result;
+    return std::nullopt;
+}
+
+//! @param  fingerprint     Fingerprint of state to be stored
+//! @param  value           Value to be stored
+//! @param  quality         Quality of the value
+
+void CompactTranspositionTable::update(uint64_t fingerprint, float value, int quality)
+{
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+    ++analysisData_.updateCount;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+    Entry & entry = find(fingerprint);
+
+    bool isUnused = entry.isUnused();
+
+    // If the entry is unused or if the new quality >= the stored quality, then store the new value. Note: It is assumed to be
+    // better to replace values of equal quality in order to dispose of old entries that may no longer be relevant.
+
+    int8_t q = clampQuality(quality);
+    if (isUnused || (q >= entry.q_))
+    {
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+        if (isUnused)
+            ++analysisData_.usage;
+        else if (entry.key_ == keyOf(fingerprint))
+            ++analysisData_.refreshed;
+        else
+            ++analysisData_.overwritten;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+        entry = Entry{keyOf(fingerprint), quantize(value), q, 0};
+    }
+    else
+    {
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+        ++analysisData_.rejected;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+    }
+}
+
+//! @param  fingerprint     Fingerprint of state to be stored
+//! @param  value           Value to be stored
+//! @param  quality         Quality of the value
+
+void CompactTranspositionTable::set(uint64_t fingerprint, float value, int quality)
+{
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+    ++analysisData_.updateCount;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+    Entry & entry = find(fingerprint);
+
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+    if (entry.isUnused())
+        ++analysisData_.usage;
+    else if (entry.key_ == keyOf(fingerprint))
+        ++analysisData_.refreshed;
+    else
+        ++analysisData_.overwritten;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+    // Store the state, value and quality
+    entry = Entry{keyOf(fingerprint), quantize(value), clampQuality(quality), 0};
+}
+
+//! The T-table is persistent. So in order to gradually dispose of entries that are no longer relevant, entries that have not been
+//! referenced for a while are removed.
+
+void CompactTranspositionTable::age()
+{
+    for (size_t i = 0; i < size_; ++i)
+    {
+        Entry & entry = table_[i];
+        if (!entry.isUnused())
+        {
+            if (entry.age_ < UINT8_MAX)
+                ++entry.age_;
+            if (entry.age_ > maxAge_)
+            {
+                entry.clear();
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+                --analysisData_.usage;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+            }
+        }
+    }
+}
+
+//! Since only part of the fingerprint is stored, an entry can be moved only if its slot in the resized table is implied by its slot
+//! in the current table. That is the case when the table shrinks by a whole factor (for example, from one power of two to a smaller
+//! one). Otherwise, the entries are dropped. If two entries end up in the same slot, the one with the higher quality is kept (or
+//! the more recently referenced one, if their qualities are equal). A smaller table implies fewer bits of the fingerprint, so the
+//! effective key of the kept entries is narrower (see the class description). The resized table is built before the current one is
+//! released, so both are in memory while the table is resized.
+//!
+//! @param  size        Number of entries in the resized table (at least 1). If it is the current size and the entries are kept,
+//!                     then nothing is done.
+//! @param  keepEntries If false, the resized table is empty
+
+void CompactTranspositionTable::resize(size_t size, bool keepEntries)
+{
+    // A table must have at least one entry
+    size = std::max<size_t>(size, 1);
+    if (size == size_ && keepEntries)
+        return;
+
+    std::unique_ptr<Entry[]> table(new Entry[size]);
+    invalidate(table.get(), size, 0);
+
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+    analysisData_.usage = 0;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+    if (keepEntries && size_ % size == 0)
+    {
+        // The fingerprint of the entry in slot i is i modulo the current size, so it is i modulo the new size, too
+        for (size_t i = 0; i < size_; ++i)
+        {
+            Entry const & entry = table_[i];
+            if (entry.isUnused())
+                continue;
+
+            Entry & slot = table[i % size];
+            if (slot.isUnused())
+            {
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+                ++analysisData_.usage;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+                slot = entry;
+            }
+            else if (entry.q_ > slot.q_ || (entry.q_ == slot.q_ && entry.age_ < slot.age_))
+            {
+                slot = entry;
+            }
+        }
+    }
+
+    table_ = std::move(table);
+    size_  = size;
+}
+
+//! Clearing a large table is limited by memory bandwidth, so the table is divided among several threads.
+//!
+//! @param  threads     Maximum number of threads to use, or 0 to use one per hardware thread
+
+void CompactTranspositionTable::clear(unsigned threads)
+{
+    invalidate(table_.get(), size_, threads);
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+    analysisData_.usage = 0;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+}
+
+//! The entries are sampled at evenly spaced intervals. See TranspositionTable::occupancy().
+//!
+//! @param  samples     Number of entries to examine. If this is at least size(), the result is exact.
+//!
+//! @return Fraction of the sampled entries that are in use
+
+float CompactTranspositionTable::occupancy(size_t samples) const
+{
+    size_t stride = std::max<size_t>(1, size_ / std::max<size_t>(1, samples));
+    size_t used   = 0;
+    size_t count  = 0;
+    for (size_t i = 0; i < size_ && count < samples; i += stride, ++count)
+    {
+        if (!table_[i].isUnused())
+            ++used;
+    }
+    return (count > 0) ? (float)used / (float)count : 0.0f;
+}
+
+void CompactTranspositionTable::invalidate(Entry * table, size_t size, unsigned threads)
+{
+    // The entries are not touched when they are allocated, so this is the only pass over the memory
+    parallelForRanges(size, threads, [table](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            table[i].clear();
+        }
+    });
+}
+
+// Win/loss values are given dedicated codes, one for each distance to the win/loss, so that they are reproduced exactly. All other
+// values are mapped linearly onto the remaining codes.
+int16_t CompactTranspositionTable::quantize(float value) const
+{
+    int distance = mateDistance_.distance(value);
+    if (distance >= 0)
+        return static_cast<int16_t>(mateDistance_.isAliceWin(value) ? ALICE_WINS_CODE - distance : BOB_WINS_CODE + distance);
+
+    long code = std::lround((value - midValue_) * scale_);
+    return static_cast<int16_t>(std::clamp(code, -(long)MAX_VALUE_CODE, (long)MAX_VALUE_CODE));
+}
+
+float CompactTranspositionTable::dequantize(int16_t code) const
+{
+    if (code > MAX_VALUE_CODE)
+        return mateDistance_.aliceWinsIn(ALICE_WINS_CODE - code);
+    if (code < -MAX_VALUE_CODE)
+        return mateDistance_.bobWinsIn(code - BOB_WINS_CODE);
+    return midValue_ + code / scale_;
+}
+
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+CompactTranspositionTable::AnalysisData::AnalysisData()
+    : usage(0)
+{
+    reset();
+}
+
+void CompactTranspositionTable::AnalysisData::reset()
+{
+    checkCount     = 0;
+    updateCount    = 0;
+    hitCount       = 0;
+    collisionCount = 0;
+    rejected       = 0;
+    overwritten    = 0;
+    refreshed      = 0;
+    // Note: usage is intentionally not reset
+}
+
+json CompactTranspositionTable::AnalysisData::toJson() const
+{
+    return json{{"checkCount", checkCount},
+                {"updateCount", updateCount},
+                {"hitCount", hitCount},
+                {"collisionCount", collisionCount},
+                {"rejected", rejected},
+                {"overwritten", overwritten},
+                {"refreshed", refreshed},
+                {"usage", usage}};
+}
+
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+} // namespace GamePlayer
@@ -1,392 +1,9 @@
 #include "GamePlayer/GameTree.h"
 
-#include "GamePlayer/GameState.h"
-#include "GamePlayer/StaticEvaluator.h"
-#include "GamePlayer/TranspositionTable.h"
-
-#include <algorithm>
-#include <functional>
-#include <limits>
-#include <nlohmann/json.hpp>
-
-using json = nlohmann::json;
-
-static int const SEF_QUALITY = 0;
-
 namespace GamePlayer
 {
 
-GameTree::GameTree(std::shared_ptr<TranspositionTable> tt,
-                   std::shared_ptr<StaticEvaluator>    sef,
-                   ResponseGenerator                   rg,
-                   int                                 maxDepth)
-    : maxDepth_(maxDepth)
-    , transpositionTable_(tt)
-    , staticEvaluator_(sef)
-    , responseGenerator_(rg)
-{
-}
-
-void GameTree::findBestResponse(std::shared_ptr<GameState> & s0) const
-{
-    Node root{s0};
-
-    if (s0->whoseTurn() == GameState::PlayerId::ALICE)
-        aliceSearch(&root, -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), 0);
-    else
-        bobSearch(&root, -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), 0);
-
-#if defined(ANALYSIS_GAME_TREE)
-    analysisData_.value = root.value;
-#endif // defined(ANALYSIS_GAME_TREE)
-}
-
-// Evaluate all of Alice's possible responses to the given state. The chosen response is the one with the highest value. The value
-// in the node is overwritten by the resulting value of the search.
-
-void GameTree::aliceSearch(Node * node, float alpha, float beta, int depth) const
-{
-    int responseDepth = depth + 1;                      // Depth of responses to this state
-    int quality       = maxDepth_ - depth;              // Quality of values at this depth (this is the depth of plies searched to
-                                                        // get the results for this ply)
-    int minResponseQuality = maxDepth_ - responseDepth; // Minimum acceptable quality of responses to this state
-
-    // Generate a list of the possible responses to this state. They are sorted in descending order hoping that a beta cutoff will
-    // occur early.
-    // Note: Preliminary values of the generated states are retrieved from the transposition table or computed by the static
-    // evaluation function.
-    NodeList responses = generateResponses(node, depth);
-
-    // If there are no responses, it can be assumed that the game is over and the value is the value of the current state. Return
-    // without assigning a response.
-    // Note: There are games in which the inability to move means that the player has lost, but that is not supported here. It must
-    // be handled elsewhere or perhaps by generating and evaluating a "pass" response.
-    if (responses.empty())
-        return;
-
-    // Sort from highest to lowest
-    std::sort(responses.begin(), responses.end(), descendingSorter);
-
-    // Evaluate each of the responses and choose the one with the highest value
-    Node bestResponse{nullptr, -std::numeric_limits<float>::max()};
-    bool pruned = false;
-    for (auto & response : responses)
-    {
-        // If the game is not over, then let's see how Bob responds (updating the value of this response)
-        if (response.value < staticEvaluator_->aliceWinsValue())
-        {
-            // The quality of a value is basically the depth of the search tree below it. The reason for checking the quality is
-            // that some of the responses have not been fully searched. If the quality of the preliminary value is not as good as
-            // the minimum quality and we haven't reached the maximum depth, then do a search. Otherwise, the response's quality is
-            // as good as the quality of a search, so use the response as is.
-            if ((response.quality < minResponseQuality) &&
-                ((responseDepth < maxDepth_) ||
-                 (shouldDoQuiescentSearch(node->value, response.value) && (responseDepth < maxDepth_ + 1))))
-            {
-                // Update the value of this response by searching Bob's responses to this response.
-                // Note: If no further search is possible, then the response's value and quality is already set by the static
-                // evaluation and response.state.response_ is left as nullptr.
-                bobSearch(&response, alpha, beta, responseDepth);
-            }
-        }
-#if defined(DEBUG_GAME_TREE_NODE_INFO)
-        printStateInfo(response, depth, alpha, beta);
-#endif // defined(DEBUG_GAME_TREE_NODE_INFO)
-
-        // Determine if this response's value is the best so far. If so, then save the value and do alpha-beta pruning
-        if (response.value > bestResponse.value)
-        {
-            // Save it
-            bestResponse = response;
-
-            // If Alice wins with this response, then there is no reason to look for anything better
-            if (bestResponse.value >= staticEvaluator_->aliceWinsValue())
-                break;
-
-            // alpha-beta pruning (beta cutoff) Here's how it works:
-            //
-            // The bob is looking for the lowest value. The 'beta' is the value of Bob's best move found so far in the previous
-            // ply. If the value of this response is higher than the beta, then Bob will abandon its move leading to this response
-            // because because the result is worse than the result of a move it has already found. As such, there is no reason to
-            // continue.
-
-            if (bestResponse.value > beta)
-            {
-                // Beta cutoff
-                pruned = true;
-#if defined(ANALYSIS_GAME_TREE)
-                ++analysisData_.betaCutoffs;
-#endif // defined(ANALYSIS_GAME_TREE)
-                break;
-            }
-
-            // alpha-beta pruning (alpha) Here's how it works:
-            //
-            // Alice is looking for the highest value. The 'alpha' is the value of Alice's best move found so far. If the value of
-            // this response is higher than the alpha, then obviously it is a better move for Alice. The alpha is subsequently
-            // passed to Bob's search so that if it finds a response with a lower value than the alpha, it won't bother continuing
-            // because it knows that Alice already has a better move and will choose it instead of allowing Bob to make a move with
-            // a lower value.
-
-            if (bestResponse.value > alpha)
-                alpha = bestResponse.value;
-        }
-    }
-
-    // Update the value of this state
-
-    node->value            = bestResponse.value;
-    node->quality          = quality;
-    node->state->response_ = bestResponse.state;
-
-    // Save the value of the state in the T-table if the ply was not pruned. Pruning results in an incorrect value because the
-    // search was interrupted. Also, note that the value is stored only if its quality is better than the quality of the value in
-    // the table.
-    if (!pruned)
-        transpositionTable_->update(node->state->fingerprint(), node->value, node->quality);
-
-    // Note: all generated states created for this ply, except the the chosen response, are released at this point.
-}
-
-// Evaluate all of Bob's possible responses to the given state. The chosen response is the one with the lowest value. The value in
-// the node is overwritten by the resulting value of the search.
-
-void GameTree::bobSearch(Node * node, float alpha, float beta, int depth) const
-{
-    int responseDepth = depth + 1;                      // Depth of responses to this state
-    int quality       = maxDepth_ - depth;              // Quality of values at this depth (this is the depth of plies searched to
-                                                        // get the results for this ply)
-    int minResponseQuality = maxDepth_ - responseDepth; // Minimum acceptable quality of responses to this state
-
-    // Generate a list of the possible responses to this state. They are sorted in ascending order hoping that a alpha cutoff will
-    // occur early.
-    // Note: Preliminary values of the generated states are retrieved from the transposition table or computed by the static
-    // evaluation function.
-    NodeList responses = generateResponses(node, depth);
-
-    // If there are no responses, it can be assumed that the game is over and the value is the value of the current state. Return
-    // without assigning a response.
-    // Note: There are games in which the inability to move means that the player has lost, but that is not supported here. It must
-    // be handled elsewhere or perhaps by generating and evaluating a "pass" response.
-    if (responses.empty())
-        return;
-
-    // Sort from lowest to highest
-    std::sort(responses.begin(), responses.end(), ascendingSorter);
-
-    // Evaluate each of the responses and choose the one with the lowest value
-    Node bestResponse{nullptr, std::numeric_limits<float>::max()};
-    bool pruned = false;
-    for (auto & response : responses)
-    {
-        // If the game is not over, then let's see how Alice responds (updating the value of this response)
-        if (response.value > staticEvaluator_->bobWinsValue())
-        {
-            // The quality of a value is basically the depth of the search tree below it. The reason for checking the quality is
-            // that some of the responses have not been fully searched. If the quality of the preliminary value is not as good as
-            // the minimum quality and we haven't reached the maximum depth, then do a search. Otherwise, the response's quality is
-            // as good as the quality of a search, so use the response as is.
-            if ((response.quality < minResponseQuality) &&
-                ((responseDepth < maxDepth_) ||
-                 (shouldDoQuiescentSearch(node->value, response.value) && (responseDepth < maxDepth_ + 1))))
-            {
-                // Update the value of this response by searching Alice's responses to this response.
-                // Note: If no further search is possible, then the response's value and quality is already set by the static
-                // evaluation and response.state.response_ is left as nullptr.
-                aliceSearch(&response, alpha, beta, responseDepth);
-            }
-        }
-#if defined(DEBUG_GAME_TREE_NODE_INFO)
-        printStateInfo(response, depth, alpha, beta);
-#endif // defined(DEBUG_GAME_TREE_NODE_INFO)
-
-        // Determine if this response's value is the best so far. If so, then save the value and do alpha-beta pruning
-        if (response.value < bestResponse.value)
-        {
-            // Save it
-            bestResponse = response;
-
-            // If Alice wins with this response, then there is no reason to look for anything better
-            if (bestResponse.value <= staticEvaluator_->bobWinsValue())
-                break;
-
-            // alpha-beta pruning (alpha cutoff) Here's how it works:
-            //
-            // Alice is looking for the highest value. The 'alpha' is the value of Alice's best move found so far in the previous
-            // ply. If the value of this response is lower than the alpha, then Alice will abandon its move leading to this
-            // response because because the result is worse than the result of a move it has already found. As such, there is no
-            // reason to continue.
-
-            if (bestResponse.value < alpha)
-            {
-                // Alpha cutoff
-                pruned = true;
-#if defined(ANALYSIS_GAME_TREE)
-                ++analysisData_.alphaCutoffs;
-#endif // defined(ANALYSIS_GAME_TREE)
-                break;
-            }
-
-            // alpha-beta pruning (beta) Here's how it works.
-            //
-            // Bob is looking for the lowest value. The 'beta' is the value of Bob's best move found so far. If the value of this
-            // response is lower than the beta, then obviously it is a better move for Bob. The beta is subsequently passed to
-            // Alice's search so that if it finds a response with a higher value than the beta, it won't bother continuing because
-            // it knows that Bob already has a better move and will choose it instead of allowing Alice to make a move with a
-            // higher value.
-
-            if (bestResponse.value < beta)
-                beta = bestResponse.value;
-        }
-    }
-
-    // Update the value of this state
-
-    node->value            = bestResponse.value;
-    node->quality          = quality;
-    node->state->response_ = bestResponse.state;
-
-    // Save the value of the state in the T-table if the ply was not pruned. Pruning results in an incorrect value because the
-    // search was interrupted. Also, note that the value is stored only if its quality is better than the quality of the value in
-    // the table.
-    if (!pruned)
-        transpositionTable_->update(node->state->fingerprint(), node->value, node->quality);
-
-    // Note: all generated states created for this ply, except the the chosen response, are released at this point.
-}
-
-GameTree::NodeList GameTree::generateResponses(Node const * node, int depth) const
-{
-    std::vector<GameState *> responses = responseGenerator_(*node->state, depth);
-
-#if defined(ANALYSIS_GAME_TREE)
-    if (depth < GamePlayer::GameTree::AnalysisData::MAX_DEPTH)
-        analysisData_.generatedCounts[depth] += (int)responses.size();
-#endif // defined(ANALYSIS_GAME_TREE)
-
-    NodeList rv;
-    rv.resize(responses.size());
-
-    // Create a list of response nodes
-    std::transform(responses.begin(),
-                   responses.end(),
-                   rv.begin(),
-                   [this, depth](GameState * state)
-                   {
-                       float value;
-                       int   quality;
-                       getValue(*state, depth, &value, &quality);
-                       return Node{std::shared_ptr<GameState>(state), value, quality};
-                   });
-
-    return rv;
-}
-
-void GameTree::getValue(GameState const & state, int depth, float * pValue, int * pQuality) const
-{
-    // SEF optimization:
-    //
-    // Since any value of any state in the T-table has already been computed by search and/or SEF, it has a quality that is at
-    // least as good as the quality of the value returned by the SEF. So, if the state being evaluated is in the T-table, then the
-    // value in the T-table is used instead of running the SEF because T-table lookup is so much faster than the SEF.
-
-    // If it is in the T-table then use that value, otherwise compute the value using SEF.
-    std::optional<TranspositionTable::CheckResult> result = transpositionTable_->check(state.fingerprint());
-    if (result)
-    {
-        *pValue   = result->first;
-        *pQuality = result->second;
-        return;
-    }
-
-#if defined(ANALYSIS_GAME_TREE)
-    if (depth < GamePlayer::GameTree::AnalysisData::MAX_DEPTH)
-        ++analysisData_.evaluatedCounts[depth];
-#endif // defined(ANALYSIS_GAME_TREE)
-
-    float value = staticEvaluator_->evaluate(state);
-
-    *pValue   = value;
-    *pQuality = SEF_QUALITY;
-
-    // Save the value of the state in the T-table
-    transpositionTable_->update(state.fingerprint(), *pValue, *pQuality);
-}
-
-#if defined(ANALYSIS_GAME_TREE)
-
-GameTree::AnalysisData::AnalysisData()
-    : value(0)
-    , alphaCutoffs(0)
-    , betaCutoffs(0)
-{
-    memset(generatedCounts, 0, sizeof(generatedCounts));
-    memset(evaluatedCounts, 0, sizeof(evaluatedCounts));
-}
-
-void GameTree::AnalysisData::reset()
-{
-    memset(generatedCounts, 0, sizeof(generatedCounts));
-    memset(evaluatedCounts, 0, sizeof(evaluatedCounts));
-
-    value        = 0.0f;
-    alphaCutoffs = 0;
-    betaCutoffs  = 0;
-
-#if defined(ANALYSIS_GAME_STATE)
-    gsAnalysisData.reset();
-#endif // defined(ANALYSIS_GAME_STATE)
-}
-
-json GameTree::AnalysisData::toJson() const
-{
-    json out = {{"generatedCounts", generatedCounts},
-                {"evaluatedCounts", evaluatedCounts},
-                {"value", value},
-                {"alphaCutoffs", alphaCutoffs},
-                {"betaCutoffs", betaCutoffs}
-
-#if defined(ANALYSIS_GAME_STATE)
-                ,
-                {"gameState", gsAnalysisData.toJson()}
-#endif // defined(ANALYSIS_GAME_STATE)
-    };
-    return out;
-}
-#endif // defined(ANALYSIS_GAME_TREE)
-
-#if defined(DEBUG_GAME_TREE_NODE_INFO)
-void GameTree::printStateInfo(Node const & node, int depth, float alpha, float beta) const
-{
-    for (int i = 0; i < depth; ++i)
-    {
-        fprintf(stderr, "%-2d  ", i);
-    }
-
-    uint64_t const fingerprint = node.state->fingerprint();
-    fprintf(stderr, "f = 0x%08llx, value = %6.2f, quality = %3d, ", fingerprint & 0xffffffff, node.value, node.quality);
-    if (alpha == -std::numeric_limits<float>::max())
-        fprintf(stderr, "alpha = -∞, ");
-    else
-        fprintf(stderr, "alpha = %6.2f, ", alpha);
-    if (beta == std::numeric_limits<float>::max())
-        fprintf(stderr, "beta = ∞\n");
-    else
-        fprintf(stderr, "beta = %6.2f\n", beta);
-}
-
-#endif // defined(DEBUG_GAME_TREE_NODE_INFO)
-
-// Sort nodes in descending order by value.
-bool GameTree::descendingSorter(Node const & a, Node const & b)
-{
-    return a.value > b.value;
-}
-
-// Sort  nodes in ascending order by value.
-bool GameTree::ascendingSorter(Node const & a, Node const & b)
-{
-    return a.value < b.value;
-}
+// The default configuration is instantiated here so that its users don't compile it
+template class BasicGameTree<DefaultGameTreePolicies>;
 
 } // namespace GamePlayer
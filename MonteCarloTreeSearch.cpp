@@ -0,0 +1,470 @@
+#include "GamePlayer/MonteCarloTreeSearch.h"
+
+#include "GamePlayer/GameState.h"
+#include "GamePlayer/StaticEvaluator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <thread>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace GamePlayer
+{
+
+namespace
+{
+// Expansion states of a node
+int const UNEXPANDED = 0; // The node's children have not been generated
+int const EXPANDING  = 1; // A thread is generating the node's children
+int const EXPANDED   = 2; // The node's children have been generated. A node with no children is terminal.
+
+// Number of nodes allocated at a time by the node pool
+size_t const CHUNK_SIZE = 4096;
+
+void atomicAdd(std::atomic<double> & a, double x)
+{
+    double old = a.load(std::memory_order_relaxed);
+    while (!a.compare_exchange_weak(old, old + x, std::memory_order_relaxed))
+    {
+    }
+}
+} // anonymous namespace
+
+// A state in the tree. A node's children are allocated contiguously from the node pool.
+//
+// The fields above 'expansion' are written before the node is published, either by the release of its parent's expansion state
+// or by the release of its own expansion state (children and childCount), and they are not modified afterwards.
+struct MonteCarloTreeSearch::Node
+{
+    std::shared_ptr<GameState> state;
+    float                      evaluation = 0.5f;    // Normalized static evaluation of the state
+    float                      prior      = 1.0f;    // Probability that this state is the best response to its parent
+    float                      lossValue  = 0.0f;    // Value that is a loss for the player responding with this state
+    Node *                     children   = nullptr; // The responses to this state
+    int                        childCount = 0;       // The number of responses to this state
+    std::atomic<int>           expansion{UNEXPANDED};
+    std::atomic<int>           visits{0};      // Number of visits, including virtual losses
+    std::atomic<double>        valueSum{0.0};  // Sum of the values of the visits, including virtual losses
+};
+
+// Allocates nodes in large chunks so that allocation is cheap and the nodes are released all at once.
+class MonteCarloTreeSearch::NodePool
+{
+public:
+    explicit NodePool(size_t maxNodes)
+        : maxNodes_(maxNodes)
+    {
+    }
+
+    // Returns n contiguous nodes, or nullptr if the pool is exhausted. If required is true, the nodes are allocated even if that
+    // exceeds the limit.
+    Node * allocate(size_t n, bool required = false)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!required && size_ + n > maxNodes_)
+            return nullptr;
+        if (chunks_.empty() || used_ + n > chunkCapacity_)
+        {
+            chunkCapacity_ = std::max(CHUNK_SIZE, n);
+            chunks_.emplace_back(new Node[chunkCapacity_]);
+            used_ = 0;
+        }
+        Node * nodes = chunks_.back().get() + used_;
+        used_ += n;
+        size_ += n;
+        return nodes;
+    }
+
+    // Returns the number of nodes allocated
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+private:
+    std::mutex                           mutex_;
+    std::vector<std::unique_ptr<Node[]>> chunks_;
+    size_t                               chunkCapacity_ = 0; // Capacity of the last chunk
+    size_t                               used_          = 0; // Number of nodes used in the last chunk
+    size_t                               size_          = 0; // Total number of nodes allocated
+    size_t                               maxNodes_;
+};
+
+// The state of a single call to findBestResponse(), shared by all of the search threads.
+class MonteCarloTreeSearch::Search
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Search(MonteCarloTreeSearch const & mcts, std::shared_ptr<GameState> const & s0, Clock::time_point deadline)
+        : mcts_(mcts)
+        , deadline_(deadline)
+        , aliceWinsValue_(mcts.staticEvaluator_->aliceWinsValue())
+        , bobWinsValue_(mcts.staticEvaluator_->bobWinsValue())
+        , pool_(std::max<size_t>(mcts.options_.maxNodes, 1))
+    {
+        root_ = pool_.allocate(1);
+        initialize(root_, s0, 0.0f);
+    }
+
+    // Generates the responses to the root, so that a root with no responses is known before the search starts
+    void expandRoot();
+
+    // Descends the tree repeatedly until time runs out or the tree is full
+    void run(uint64_t seed);
+
+    // Converts a value in the range of the static evaluator to the range [0, 1]
+    float normalize(float value) const
+    {
+        return std::clamp((value - bobWinsValue_) / (aliceWinsValue_ - bobWinsValue_), 0.0f, 1.0f);
+    }
+
+    // Converts a value in the range [0, 1] to the range of the static evaluator
+    float denormalize(float value) const { return bobWinsValue_ + value * (aliceWinsValue_ - bobWinsValue_); }
+
+private:
+    void   initialize(Node * node, std::shared_ptr<GameState> state, float lossValue);
+    bool   expand(Node * node, int depth);
+    Node * select(Node const * node) const;
+    float  rollout(GameState const & state, int depth, std::mt19937_64 & rng) const;
+
+    MonteCarloTreeSearch const & mcts_;
+    Clock::time_point            deadline_;
+    float                        aliceWinsValue_;
+    float                        bobWinsValue_;
+    std::atomic<bool>            full_{false}; // True if the tree can't grow any more
+
+public:
+    NodePool          pool_;
+    Node *            root_ = nullptr;
+    std::atomic<long> iterations_{0}; // Number of times the tree was descended
+    std::atomic<int>  maxDepth_{0};   // Depth of the deepest node reached
+};
+
+void MonteCarloTreeSearch::Search::run(uint64_t seed)
+{
+    Options const &     options = mcts_.options_;
+    int const           vl      = options.virtualLoss;
+    std::mt19937_64     rng(seed);
+    std::vector<Node *> path;
+
+    // Note: With multiple threads, the iteration limit may be exceeded by a few iterations
+    while (!full_.load(std::memory_order_relaxed) && Clock::now() < deadline_ &&
+           (options.maxIterations <= 0 || iterations_.load(std::memory_order_relaxed) < options.maxIterations))
+    {
+        // Selection: Descend the tree until reaching a leaf, adding virtual losses along the way so that other threads are
+        // discouraged from following the same path.
+        path.clear();
+        Node * node = root_;
+        float  value;
+        for (;;)
+        {
+            path.push_back(node);
+            node->visits.fetch_add(vl, std::memory_order_relaxed);
+            atomicAdd(node->valueSum, vl * node->lossValue);
+
+            int expansion = node->expansion.load(std::memory_order_acquire);
+            if (expansion == EXPANDED)
+            {
+                // A terminal state's value is its static evaluation
+                if (node->childCount == 0)
+                {
+                    value = node->evaluation;
+                    break;
+                }
+                node = select(node);
+                continue;
+            }
+
+            // Expansion: The first thread to reach an unexpanded leaf generates its responses. Other threads reaching the leaf
+            // in the meantime simply evaluate it.
+            int expected = UNEXPANDED;
+            if (expansion == UNEXPANDED && node->expansion.compare_exchange_strong(expected, EXPANDING, std::memory_order_acq_rel))
+            {
+                if (!expand(node, (int)path.size() - 1))
+                    full_.store(true, std::memory_order_relaxed);
+            }
+
+            // Evaluation
+            value = (options.rolloutDepth > 0) ? rollout(*node->state, (int)path.size() - 1, rng) : node->evaluation;
+            break;
+        }
+
+        // Backpropagation: Replace the virtual losses with the value
+        for (Node * n : path)
+        {
+            n->visits.fetch_add(1 - vl, std::memory_order_relaxed);
+            atomicAdd(n->valueSum, value - vl * n->lossValue);
+        }
+
+        iterations_.fetch_add(1, std::memory_order_relaxed);
+
+        int depth    = (int)path.size() - 1;
+        int maxDepth = maxDepth_.load(std::memory_order_relaxed);
+        while (depth > maxDepth && !maxDepth_.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+void MonteCarloTreeSearch::Search::expandRoot()
+{
+    int expected = UNEXPANDED;
+    if (root_->expansion.compare_exchange_strong(expected, EXPANDING, std::memory_order_acq_rel))
+    {
+        if (!expand(root_, 0))
+            full_.store(true, std::memory_order_relaxed);
+    }
+}
+
+// Sets the state of a new node and evaluates it. A win/loss is terminal, so it is marked as expanded with no children.
+void MonteCarloTreeSearch::Search::initialize(Node * node, std::shared_ptr<GameState> state, float lossValue)
+{
+    float value      = mcts_.staticEvaluator_->evaluate(*state);
+    node->state      = std::move(state);
+    node->evaluation = normalize(value);
+    node->lossValue  = lossValue;
+    if (value >= aliceWinsValue_ || value <= bobWinsValue_)
+        node->expansion.store(EXPANDED, std::memory_order_relaxed);
+}
+
+// Generates the responses to the node's state. Returns false if there is no room for them in the tree (which is never the case for
+// the root).
+bool MonteCarloTreeSearch::Search::expand(Node * node, int depth)
+{
+    std::vector<std::unique_ptr<GameState>> responses;
+    for (GameState * response : mcts_.responseGenerator_(*node->state, depth))
+        responses.emplace_back(response);
+
+    // No responses means the game is over
+    if (responses.empty())
+    {
+        node->expansion.store(EXPANDED, std::memory_order_release);
+        return true;
+    }
+
+    // The root's responses are always allocated, since a response can't be chosen otherwise
+    Node * children = pool_.allocate(responses.size(), depth == 0);
+    if (!children)
+    {
+        node->expansion.store(UNEXPANDED, std::memory_order_release);
+        return false;
+    }
+
+    // A response is chosen by the player whose turn it is, so its loss value is a loss for that player
+    bool  aliceToMove = (node->state->whoseTurn() == GameState::PlayerId::ALICE);
+    float lossValue   = aliceToMove ? 0.0f : 1.0f;
+    for (size_t i = 0; i < responses.size(); ++i)
+    {
+        initialize(&children[i], std::shared_ptr<GameState>(responses[i].release()), lossValue);
+    }
+
+    // PUCT priors are a softmax of the responses' static evaluations from the point of view of the player to move
+    Options const & options = mcts_.options_;
+    if (options.selection == Selection::PUCT && options.priorTemperature > 0.0f)
+    {
+        float best = -std::numeric_limits<float>::max();
+        for (size_t i = 0; i < responses.size(); ++i)
+        {
+            float v = aliceToMove ? children[i].evaluation : 1.0f - children[i].evaluation;
+            best    = std::max(best, v);
+        }
+        float sum = 0.0f;
+        for (size_t i = 0; i < responses.size(); ++i)
+        {
+            float v           = aliceToMove ? children[i].evaluation : 1.0f - children[i].evaluation;
+            children[i].prior = std::exp((v - best) / options.priorTemperature);
+            sum += children[i].prior;
+        }
+        for (size_t i = 0; i < responses.size(); ++i)
+        {
+            children[i].prior /= sum;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < responses.size(); ++i)
+        {
+            children[i].prior = 1.0f / (float)responses.size();
+        }
+    }
+
+    node->children   = children;
+    node->childCount = (int)responses.size();
+    node->expansion.store(EXPANDED, std::memory_order_release);
+    return true;
+}
+
+// Returns the child with the highest UCT/PUCT score from the point of view of the player to move
+MonteCarloTreeSearch::Node * MonteCarloTreeSearch::Search::select(Node const * node) const
+{
+    Options const & options     = mcts_.options_;
+    bool            aliceToMove = (node->state->whoseTurn() == GameState::PlayerId::ALICE);
+    float           n           = (float)std::max(node->visits.load(std::memory_order_relaxed), 1);
+    float           sqrtN       = std::sqrt(n);
+    float           logN        = std::log(n);
+
+    Node * best      = nullptr;
+    float  bestScore = -std::numeric_limits<float>::max();
+    for (int i = 0; i < node->childCount; ++i)
+    {
+        Node * child  = &node->children[i];
+        int    visits = child->visits.load(std::memory_order_relaxed);
+
+        // An unvisited child's value is estimated by its static evaluation
+        float q = (visits > 0) ? (float)(child->valueSum.load(std::memory_order_relaxed) / visits) : child->evaluation;
+        if (!aliceToMove)
+            q = 1.0f - q;
+
+        float score;
+        if (options.selection == Selection::PUCT)
+            score = q + options.exploration * child->prior * sqrtN / (float)(1 + visits);
+        else if (visits > 0)
+            score = q + options.exploration * std::sqrt(logN / (float)visits);
+        else
+            score = std::numeric_limits<float>::max() / 2.0f + q; // Unvisited children first, best evaluation first
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            best      = child;
+        }
+    }
+    return best;
+}
+
+// Plays a few plies from the given state, usually choosing the response with the best static evaluation, and returns the
+// normalized static evaluation of the final state.
+float MonteCarloTreeSearch::Search::rollout(GameState const & state, int depth, std::mt19937_64 & rng) const
+{
+    Options const &                       options = mcts_.options_;
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    std::unique_ptr<GameState>            current;
+    GameState const *                     s     = &state;
+    float                                 value = mcts_.staticEvaluator_->evaluate(state);
+
+    for (int ply = 0; ply < options.rolloutDepth; ++ply)
+    {
+        // Stop if the game is over
+        if (value >= aliceWinsValue_ || value <= bobWinsValue_)
+            break;
+
+        std::vector<std::unique_ptr<GameState>> responses;
+        for (GameState * response : mcts_.responseGenerator_(*s, depth + ply))
+            responses.emplace_back(response);
+        if (responses.empty())
+            break;
+
+        bool               aliceToMove = (s->whoseTurn() == GameState::PlayerId::ALICE);
+        std::vector<float> values(responses.size());
+        size_t             chosen = 0;
+        for (size_t i = 0; i < responses.size(); ++i)
+        {
+            values[i] = mcts_.staticEvaluator_->evaluate(*responses[i]);
+            if (aliceToMove ? (values[i] > values[chosen]) : (values[i] < values[chosen]))
+                chosen = i;
+        }
+        if (uniform(rng) < options.rolloutEpsilon)
+            chosen = std::uniform_int_distribution<size_t>(0, responses.size() - 1)(rng);
+
+        current = std::move(responses[chosen]);
+        s       = current.get();
+        value   = values[chosen];
+    }
+
+    return normalize(value);
+}
+
+MonteCarloTreeSearch::MonteCarloTreeSearch(std::shared_ptr<StaticEvaluator> sef, ResponseGenerator rg, Options const & options)
+    : staticEvaluator_(sef)
+    , responseGenerator_(rg)
+    , options_(options)
+{
+}
+
+MonteCarloTreeSearch::MonteCarloTreeSearch(std::shared_ptr<StaticEvaluator> sef, ResponseGenerator rg)
+    : MonteCarloTreeSearch(sef, rg, Options())
+{
+}
+
+float MonteCarloTreeSearch::findBestResponse(std::shared_ptr<GameState> & s0, std::chrono::milliseconds budget) const
+{
+    Search search(*this, s0, Search::Clock::now() + budget);
+    search.expandRoot();
+
+    // If the game is over (the root is a win/loss or it has no responses), then there is nothing to search
+    Node const * root = search.root_;
+    if (root->expansion.load() == EXPANDED && root->childCount == 0)
+    {
+        s0->response_ = nullptr;
+        return search.denormalize(root->evaluation);
+    }
+
+    // Search on all threads, including this one
+    std::vector<std::thread> threads;
+    for (int i = 1; i < options_.threads; ++i)
+    {
+        threads.emplace_back([&search, this, i]() { search.run(options_.seed + (uint64_t)i); });
+    }
+    search.run(options_.seed);
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    // The chosen response is the most visited one, since its value is the most reliable
+    Node const * best = nullptr;
+    for (int i = 0; i < root->childCount; ++i)
+    {
+        Node const * child = &root->children[i];
+        if (!best || child->visits.load() > best->visits.load())
+            best = child;
+    }
+    s0->response_ = best ? best->state : nullptr;
+
+    int   visits = root->visits.load();
+    float value  = search.denormalize((visits > 0) ? (float)(root->valueSum.load() / visits) : root->evaluation);
+
+#if defined(ANALYSIS_GAME_TREE)
+    analysisData_.iterations = search.iterations_.load();
+    analysisData_.nodes      = search.pool_.size();
+    analysisData_.maxDepth   = search.maxDepth_.load();
+    analysisData_.rootVisits = visits;
+    analysisData_.value      = value;
+#endif // defined(ANALYSIS_GAME_TREE)
+
+    return value;
+}
+
+#if defined(ANALYSIS_GAME_TREE)
+
+MonteCarloTreeSearch::AnalysisData::AnalysisData()
+{
+    reset();
+}
+
+void MonteCarloTreeSearch::AnalysisData::reset()
+{
+    iterations = 0;
+    nodes      = 0;
+    maxDepth   = 0;
+    rootVisits = 0;
+    value      = 0.0f;
+}
+
+json MonteCarloTreeSearch::AnalysisData::toJson() const
+{
+    return json{{"iterations", iterations}, {"nodes", nodes}, {"maxDepth", maxDepth}, {"rootVisits", rootVisits}, {"value", value}};
+}
+
+#endif // defined(ANALYSIS_GAME_TREE)
+
+} // namespace GamePlayer
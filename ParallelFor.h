@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace GamePlayer
+{
+// Calls f(begin, end) for consecutive ranges of the indexes [0, size) on several threads, and returns when all are done.
+//
+// This is for touching all of the entries of a large table, which is limited by memory bandwidth that one thread can't use up. A
+// small table is done on the calling thread. If starting a thread or f throws (on any thread), the threads already started are
+// joined before the first exception is passed on.
+//
+// threads is the maximum number of threads to use, or 0 to use one per hardware thread.
+template <typename Function>
+void parallelForRanges(size_t size, unsigned threads, Function f)
+{
+    size_t constexpr MIN_RANGE = 1 << 20; // Smallest range worth starting a thread for
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t n = std::min<size_t>(threads, std::max<size_t>(1, size / MIN_RANGE));
+    if (n <= 1)
+    {
+        f(size_t(0), size);
+        return;
+    }
+
+    size_t                          range = (size + n - 1) / n;
+    std::vector<std::thread>        workers;
+    std::vector<std::exception_ptr> errors(n); // An exception thrown by f on each thread
+    auto                            joinAll = [&workers]() {
+        for (std::thread & worker : workers)
+        {
+            worker.join();
+        }
+    };
+
+    workers.reserve(n - 1);
+    try
+    {
+        size_t i = 1;
+        for (size_t begin = range; begin < size; begin += range, ++i)
+        {
+            workers.emplace_back(
+                [&f, &error = errors[i]](size_t b, size_t e) {
+                    try
+                    {
+                        f(b, e);
+                    }
+                    catch (...)
+                    {
+                        error = std::current_exception();
+                    }
+                },
+                begin,
+                std::min(begin + range, size));
+        }
+        f(size_t(0), range);
+    }
+    catch (...)
+    {
+        joinAll();
+        throw;
+    }
+    joinAll();
+
+    for (std::exception_ptr const & error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+} // namespace GamePlayer
@@ -0,0 +1,200 @@
+#include "GamePlayer/PositionDatabase.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else // defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // defined(_WIN32)
+
+namespace GamePlayer
+{
+
+namespace
+{
+// File header. It is followed by the records.
+struct Header
+{
+    char     magic[4]; // "GPDB"
+    uint32_t version;  // Format version
+    uint64_t count;    // Number of records
+};
+static_assert(sizeof(Header) == 16, "Header should be 16 bytes");
+
+char const     MAGIC[4] = {'G', 'P', 'D', 'B'};
+uint32_t const VERSION  = 1;
+
+// Number of interpolation steps before falling back to a binary search. Interpolation converges very quickly on uniformly
+// distributed keys, and the fallback bounds the worst case.
+int const MAX_INTERPOLATION_STEPS = 4;
+} // anonymous namespace
+
+PositionDatabase::~PositionDatabase()
+{
+    unmap();
+}
+
+std::shared_ptr<PositionDatabase> PositionDatabase::open(std::string const & path)
+{
+    std::shared_ptr<PositionDatabase> db(new PositionDatabase);
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+    db->file_ = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(Header))
+        return nullptr;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+        return nullptr;
+    db->mappingHandle_ = mapping;
+
+    void * view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+        return nullptr;
+    db->mapping_     = view;
+    db->mappingSize_ = (size_t)size.QuadPart;
+#else  // defined(_WIN32)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(Header))
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    void * view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping remains valid after the file is closed
+    if (view == MAP_FAILED)
+        return nullptr;
+
+    // Lookups are scattered, so read-ahead would only waste I/O
+    madvise(view, (size_t)info.st_size, MADV_RANDOM);
+
+    db->mapping_     = view;
+    db->mappingSize_ = (size_t)info.st_size;
+#endif // defined(_WIN32)
+
+    // Validate the header and the size of the file
+    Header const * header = static_cast<Header const *>(db->mapping_);
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION)
+        return nullptr;
+    if (header->count > (db->mappingSize_ - sizeof(Header)) / sizeof(Record))
+        return nullptr;
+
+    db->records_ = reinterpret_cast<Record const *>(header + 1);
+    db->count_   = (size_t)header->count;
+    return db;
+}
+
+bool PositionDatabase::write(std::string const & path, std::vector<Record> records)
+{
+    // Sort by fingerprint, and then by descending quality so that the best record of each state is first
+    std::sort(records.begin(),
+              records.end(),
+              [](Record const & a, Record const & b)
+              { return (a.fingerprint < b.fingerprint) || ((a.fingerprint == b.fingerprint) && (a.quality > b.quality)); });
+
+    // Remove duplicates, keeping the best
+    records.erase(std::unique(records.begin(),
+                              records.end(),
+                              [](Record const & a, Record const & b) { return a.fingerprint == b.fingerprint; }),
+                  records.end());
+
+    FILE * fp = fopen(path.c_str(), "wb");
+    if (fp == nullptr)
+        return false;
+
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.count   = records.size();
+
+    bool ok = (fwrite(&header, sizeof(header), 1, fp) == 1);
+    if (ok && !records.empty())
+        ok = (fwrite(records.data(), sizeof(Record), records.size(), fp) == records.size());
+    ok = (fclose(fp) == 0) && ok;
+    return ok;
+}
+
+//! @param  fingerprint     Fingerprint of the state to find
+//!
+//! @return the record, or nothing if the state is not in the database
+
+std::optional<PositionDatabase::Record> PositionDatabase::find(uint64_t fingerprint) const
+{
+    if (count_ == 0)
+        return std::nullopt;
+
+    size_t lo = 0;
+    size_t hi = count_ - 1;
+
+    // Interpolation search
+    for (int i = 0; i < MAX_INTERPOLATION_STEPS && lo < hi; ++i)
+    {
+        uint64_t loKey = records_[lo].fingerprint;
+        uint64_t hiKey = records_[hi].fingerprint;
+        if (fingerprint < loKey || fingerprint > hiKey)
+            return std::nullopt;
+
+        // Estimate the position of the key assuming a uniform distribution between the bounds
+        size_t probe = lo + (size_t)((long double)(fingerprint - loKey) / (long double)(hiKey - loKey) * (long double)(hi - lo));
+        probe        = std::clamp(probe, lo, hi);
+
+        uint64_t key = records_[probe].fingerprint;
+        if (key == fingerprint)
+            return records_[probe];
+        if (key < fingerprint)
+            lo = probe + 1;
+        else if (probe > lo)
+            hi = probe - 1;
+        else
+            return std::nullopt;
+    }
+
+    // Binary search the remainder
+    Record const * first  = records_ + lo;
+    Record const * last   = records_ + hi + 1;
+    Record const * record = std::lower_bound(
+        first, last, fingerprint, [](Record const & r, uint64_t key) { return r.fingerprint < key; });
+    if (record != last && record->fingerprint == fingerprint)
+        return *record;
+
+    return std::nullopt;
+}
+
+void PositionDatabase::unmap()
+{
+#if defined(_WIN32)
+    if (mapping_ != nullptr)
+        UnmapViewOfFile(mapping_);
+    if (mappingHandle_ != nullptr)
+        CloseHandle(mappingHandle_);
+    if (file_ != nullptr)
+        CloseHandle(file_);
+    file_          = nullptr;
+    mappingHandle_ = nullptr;
+#else  // defined(_WIN32)
+    if (mapping_ != nullptr)
+        munmap(const_cast<void *>(mapping_), mappingSize_);
+#endif // defined(_WIN32)
+    mapping_     = nullptr;
+    mappingSize_ = 0;
+    records_     = nullptr;
+    count_       = 0;
+}
+
+} // namespace GamePlayer
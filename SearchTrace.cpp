@@ -0,0 +1,144 @@
+#include "GamePlayer/SearchTrace.h"
+
+#include <cstring>
+
+namespace GamePlayer
+{
+
+namespace
+{
+// File header. It is followed by the events.
+struct Header
+{
+    char     magic[4];  // "GPTR"
+    uint32_t version;   // Format version
+    uint32_t eventSize; // Size of an event
+    uint32_t reserved;
+};
+static_assert(sizeof(Header) == 16, "Header should be 16 bytes");
+
+char const     MAGIC[4] = {'G', 'P', 'T', 'R'};
+uint32_t const VERSION  = 1;
+
+// Number of events buffered before they are written to a file
+size_t const FILE_BUFFER_SIZE = 4096;
+
+bool writeHeader(FILE * fp)
+{
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version   = VERSION;
+    header.eventSize = sizeof(SearchTrace::Event);
+    header.reserved  = 0;
+    return fwrite(&header, sizeof(header), 1, fp) == 1;
+}
+
+size_t roundUpToPowerOfTwo(size_t n)
+{
+    size_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+} // anonymous namespace
+
+SearchTrace::SearchTrace(size_t capacity, FILE * file)
+    : buffer_(capacity)
+    , mask_(capacity - 1)
+    , file_(file)
+    , start_(std::chrono::steady_clock::now())
+{
+}
+
+SearchTrace::~SearchTrace()
+{
+    if (file_)
+    {
+        flush();
+        fclose(file_);
+    }
+}
+
+std::shared_ptr<SearchTrace> SearchTrace::createRingBuffer(size_t capacity)
+{
+    return std::shared_ptr<SearchTrace>(new SearchTrace(roundUpToPowerOfTwo(capacity), nullptr));
+}
+
+std::shared_ptr<SearchTrace> SearchTrace::createFile(std::string const & path)
+{
+    FILE * fp = fopen(path.c_str(), "wb");
+    if (fp == nullptr)
+        return nullptr;
+    if (!writeHeader(fp))
+    {
+        fclose(fp);
+        return nullptr;
+    }
+    return std::shared_ptr<SearchTrace>(new SearchTrace(FILE_BUFFER_SIZE, fp));
+}
+
+std::vector<SearchTrace::Event> SearchTrace::events() const
+{
+    size_t capacity = buffer_.size();
+
+    // If the ring buffer has not wrapped around (or this is a file trace), then the events are in order from the start.
+    if (next_ <= capacity)
+        return std::vector<Event>(buffer_.begin(), buffer_.begin() + next_);
+
+    // Otherwise, the oldest event is the one that will be overwritten next
+    size_t             oldest = next_ & mask_;
+    std::vector<Event> events(buffer_.begin() + oldest, buffer_.end());
+    events.insert(events.end(), buffer_.begin(), buffer_.begin() + oldest);
+    return events;
+}
+
+bool SearchTrace::flush()
+{
+    if (!file_)
+        return true;
+
+    // Note: A file trace flushes whenever the buffer fills, so next_ never exceeds the capacity.
+    if (next_ > 0 && fwrite(buffer_.data(), sizeof(Event), next_, file_) != next_)
+        failed_ = true;
+    if (fflush(file_) != 0)
+        failed_ = true;
+    next_ = 0;
+    return !failed_;
+}
+
+bool SearchTrace::save(std::string const & path) const
+{
+    FILE * fp = fopen(path.c_str(), "wb");
+    if (fp == nullptr)
+        return false;
+
+    std::vector<Event> e  = events();
+    bool               ok = writeHeader(fp);
+    if (ok && !e.empty())
+        ok = (fwrite(e.data(), sizeof(Event), e.size(), fp) == e.size());
+    ok = (fclose(fp) == 0) && ok;
+    return ok;
+}
+
+bool SearchTrace::read(std::string const & path, std::vector<Event> * events)
+{
+    FILE * fp = fopen(path.c_str(), "rb");
+    if (fp == nullptr)
+        return false;
+
+    Header header;
+    bool   ok = (fread(&header, sizeof(header), 1, fp) == 1) && (memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0) &&
+              (header.version == VERSION) && (header.eventSize == sizeof(Event));
+
+    events->clear();
+    Event event;
+    while (ok && fread(&event, sizeof(event), 1, fp) == 1)
+    {
+        events->push_back(event);
+    }
+
+    fclose(fp);
+    return ok;
+}
+
+} // namespace GamePlayer
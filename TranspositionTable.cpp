@@ -1,7 +1,10 @@
 #include "GamePlayer/TranspositionTable.h"
 
+#include "ParallelFor.h"
+
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <cassert>
 
 using json = nlohmann::json;
@@ -13,14 +16,20 @@ namespace GamePlayer
 //! @param  maxAge  Maximum age of entries allowed in the table
 
 TranspositionTable::TranspositionTable(size_t size, int maxAge)
-    : table_(size)
+    : table_(new Entry[std::max<size_t>(size, 1)]) // A table must have at least one entry
+    , size_(std::max<size_t>(size, 1))
     , maxAge_(maxAge)
 {
     // Invalidate all entries in the table
-    for (auto & entry : table_)
-    {
-        entry.clear();
-    }
+    invalidate(table_.get(), size_, 0);
+}
+
+//! @param  budget  Maximum amount of memory used by the entries
+//! @param  maxAge  Maximum age of entries allowed in the table
+
+TranspositionTable::TranspositionTable(MemoryBudget budget, int maxAge)
+    : TranspositionTable(entriesInBudget(budget, sizeof(Entry)), maxAge)
+{
 }
 
 //! This function returns the value of a state if the value is stored in the table. Otherwise, false is returned and the return
@@ -167,8 +176,9 @@ void TranspositionTable::set(uint64_t fingerprint, float value, int quality)
 
 void TranspositionTable::age()
 {
-    for (auto & entry : table_)
+    for (size_t i = 0; i < size_; ++i)
     {
+        Entry & entry = table_[i];
         if (entry.fingerprint_ != Entry::UNUSED)
         {
             ++entry.age_;
@@ -183,6 +193,98 @@ void TranspositionTable::age()
     }
 }
 
+//! If the entries are kept, each one is moved to its slot in the resized table. If two entries end up in the same slot, the one
+//! with the higher quality is kept (or the more recently referenced one, if their qualities are equal). The resized table is built
+//! before the current one is released, so both are in memory while the table is resized.
+//!
+//! @param  size        Number of entries in the resized table (at least 1). If it is the current size and the entries are kept,
+//!                     then nothing is done.
+//! @param  keepEntries If false, the resized table is empty
+
+void TranspositionTable::resize(size_t size, bool keepEntries)
+{
+    // A table must have at least one entry
+    size = std::max<size_t>(size, 1);
+    if (size == size_ && keepEntries)
+        return;
+
+    std::unique_ptr<Entry[]> table(new Entry[size]);
+    invalidate(table.get(), size, 0);
+
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+    analysisData_.usage = 0;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+    if (keepEntries)
+    {
+        for (size_t i = 0; i < size_; ++i)
+        {
+            Entry const & entry = table_[i];
+            if (entry.fingerprint_ == Entry::UNUSED)
+                continue;
+
+            Entry & slot = table[entry.fingerprint_ % size];
+            if (slot.fingerprint_ == Entry::UNUSED)
+            {
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+                ++analysisData_.usage;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+                slot = entry;
+            }
+            else if (entry.q_ > slot.q_ || (entry.q_ == slot.q_ && entry.age_ < slot.age_))
+            {
+                slot = entry;
+            }
+        }
+    }
+
+    table_ = std::move(table);
+    size_  = size;
+}
+
+//! Clearing a large table is limited by memory bandwidth, so the table is divided among several threads.
+//!
+//! @param  threads     Maximum number of threads to use, or 0 to use one per hardware thread
+
+void TranspositionTable::clear(unsigned threads)
+{
+    invalidate(table_.get(), size_, threads);
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+    analysisData_.usage = 0;
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+}
+
+//! The entries are sampled at evenly spaced intervals. Since the fingerprints are uniformly distributed, the entries in use are
+//! too, so a small sample gives a good estimate. Unlike AnalysisData::usage, this is always available.
+//!
+//! @param  samples     Number of entries to examine. If this is at least size(), the result is exact.
+//!
+//! @return Fraction of the sampled entries that are in use
+
+float TranspositionTable::occupancy(size_t samples) const
+{
+    size_t stride = std::max<size_t>(1, size_ / std::max<size_t>(1, samples));
+    size_t used   = 0;
+    size_t count  = 0;
+    for (size_t i = 0; i < size_ && count < samples; i += stride, ++count)
+    {
+        if (table_[i].fingerprint_ != Entry::UNUSED)
+            ++used;
+    }
+    return (count > 0) ? (float)used / (float)count : 0.0f;
+}
+
+void TranspositionTable::invalidate(Entry * table, size_t size, unsigned threads)
+{
+    // The entries are not touched when they are allocated, so this is the only pass over the memory
+    parallelForRanges(size, threads, [table](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            table[i].clear();
+        }
+    });
+}
+
 #if defined(ANALYSIS_TRANSPOSITION_TABLE)
 
 TranspositionTable::AnalysisData::AnalysisData()
@@ -0,0 +1,148 @@
+// Compares TranspositionTable and CompactTranspositionTable at an equal memory budget.
+//
+// A stream of checks and updates is run against both tables. The positions are drawn from a skewed distribution over a set that is
+// larger than either table, so the hit rate is limited by the table's capacity. The hit rate, the number of false hits, and the
+// value error introduced by quantization are reported for each table.
+//
+// Usage: GamePlayer_bench-TranspositionTableDensity [budget in MiB] [operations]
+
+#include "GamePlayer/CompactTranspositionTable.h"
+#include "GamePlayer/StaticEvaluator.h"
+#include "GamePlayer/TranspositionTable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace GamePlayer;
+
+namespace
+{
+class RangeEvaluator : public StaticEvaluator
+{
+public:
+    float evaluate(GameState const &) const override { return 0.0f; }
+    float aliceWinsValue() const override { return 1000.0f; }
+    float bobWinsValue() const override { return -1000.0f; }
+};
+
+uint64_t splitMix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+struct Results
+{
+    size_t entries   = 0;
+    long   checks    = 0;
+    long   hits      = 0;
+    long   falseHits = 0;
+    double sumError  = 0.0;
+    double maxError  = 0.0;
+    double seconds   = 0.0;
+};
+
+// The true value of a position, derived from its index. Roughly 1 in 64 positions is a win or a loss.
+float trueValue(uint64_t i, StaticEvaluator const & sef)
+{
+    uint64_t r = splitMix64(i ^ 0x5555555555555555ULL);
+    if ((r & 63) == 0)
+        return (r & 64) ? sef.aliceWinsValue() : sef.bobWinsValue();
+    double u = (double)(r >> 11) / (double)(1ULL << 53);
+    return (float)(sef.bobWinsValue() + u * (sef.aliceWinsValue() - sef.bobWinsValue()));
+}
+
+template <typename Table>
+Results run(Table & table, size_t entries, uint64_t positions, long operations, StaticEvaluator const & sef)
+{
+    Results results;
+    results.entries = entries;
+
+    std::mt19937_64                        rng(12345);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::uniform_int_distribution<int>     quality(0, 8);
+
+    auto start = std::chrono::steady_clock::now();
+    for (long n = 0; n < operations; ++n)
+    {
+        // Skewed toward low indexes so that some positions recur often, as they do in a search
+        double   u  = uniform(rng);
+        uint64_t i  = std::min<uint64_t>((uint64_t)(u * u * u * positions), positions - 1);
+        uint64_t fp = splitMix64(i);
+        float    v  = trueValue(i, sef);
+
+        ++results.checks;
+        auto result = table.check(fp);
+        if (result)
+        {
+            double error = std::abs((double)result->first - (double)v);
+            // An error larger than a quantization step means the entry belongs to a different position
+            if (error > 1.0)
+            {
+                ++results.falseHits;
+            }
+            else
+            {
+                ++results.hits;
+                results.sumError += error;
+                results.maxError = std::max(results.maxError, error);
+            }
+        }
+        else
+        {
+            table.update(fp, v, quality(rng));
+        }
+    }
+    results.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return results;
+}
+
+void print(char const * name, Results const & r)
+{
+    printf("%-28s %12zu %9.4f %10ld %12.6f %12.6f %9.2f\n",
+           name,
+           r.entries,
+           (double)r.hits / (double)r.checks,
+           r.falseHits,
+           r.hits ? r.sumError / (double)r.hits : 0.0,
+           r.maxError,
+           r.seconds * 1e9 / (double)r.checks);
+}
+} // anonymous namespace
+
+int main(int argc, char ** argv)
+{
+    size_t budgetMiB  = (argc > 1) ? (size_t)strtoull(argv[1], nullptr, 10) : 64;
+    long   operations = (argc > 2) ? strtol(argv[2], nullptr, 10) : 20000000;
+    size_t budget     = budgetMiB * 1024 * 1024;
+
+    RangeEvaluator sef;
+
+    size_t standardEntries = budget / 16;
+    size_t compactEntries  = budget / 8;
+
+    // The set of positions is larger than either table so that capacity matters
+    uint64_t positions = (uint64_t)compactEntries * 4;
+
+    printf("budget = %zu MiB, positions = %llu, operations = %ld\n\n", budgetMiB, (unsigned long long)positions, operations);
+    printf("%-28s %12s %9s %10s %12s %12s %9s\n", "table", "entries", "hit rate", "false hits", "mean error", "max error", "ns/op");
+
+    {
+        TranspositionTable table(standardEntries, 8);
+        print("TranspositionTable", run(table, standardEntries, positions, operations, sef));
+    }
+    {
+        CompactTranspositionTable table(compactEntries, 8, sef);
+        print("CompactTranspositionTable", run(table, compactEntries, positions, operations, sef));
+        printf("\nCompactTranspositionTable quantization error bound: %f\n", table.maxQuantizationError());
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Measures the effect of TranspositionTable::prefetch() on probing the responses of a node.
+//
+// The table is much larger than the last-level cache, so nearly every probe misses the cache. For each simulated node, a set of
+// sibling fingerprints is probed either one at a time, or after prefetching the entries of all of the siblings, which is what
+// GameTree does. Half of the fingerprints are in the table.
+//
+// Usage: GamePlayer_bench-TranspositionTablePrefetch [table size in MiB] [responses per node] [nodes]
+
+#include "GamePlayer/CompactTranspositionTable.h"
+#include "GamePlayer/StaticEvaluator.h"
+#include "GamePlayer/TranspositionTable.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace GamePlayer;
+
+namespace
+{
+class RangeEvaluator : public StaticEvaluator
+{
+public:
+    float evaluate(GameState const &) const override { return 0.0f; }
+    float aliceWinsValue() const override { return 1000.0f; }
+    float bobWinsValue() const override { return -1000.0f; }
+};
+
+uint64_t splitMix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Probes the fingerprints in groups of siblings and returns the time per probe in nanoseconds
+template <typename Table>
+double probe(Table const & table, std::vector<uint64_t> const & fingerprints, size_t siblings, bool prefetch, int * hits)
+{
+    *hits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t node = 0; node + siblings <= fingerprints.size(); node += siblings)
+    {
+        uint64_t const * children = &fingerprints[node];
+        if (prefetch)
+        {
+            for (size_t i = 0; i < siblings; ++i)
+                table.prefetch(children[i]);
+        }
+        for (size_t i = 0; i < siblings; ++i)
+        {
+            if (table.check(children[i]))
+                ++*hits;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (double)fingerprints.size();
+}
+
+template <typename Table>
+void run(char const * name, Table & table, size_t entries, size_t siblings, size_t nodes)
+{
+    // Fill the table
+    for (size_t i = 0; i < entries; ++i)
+        table.set(splitMix64(i), (float)(i % 1000), 1);
+
+    // Half of the probed states are in the table
+    std::vector<uint64_t> fingerprints(siblings * nodes);
+    for (size_t i = 0; i < fingerprints.size(); ++i)
+    {
+        uint64_t r      = splitMix64(i + 0x7777777777777777ULL);
+        fingerprints[i] = (r & 1) ? splitMix64(r % entries) : r;
+    }
+
+    int    hitsWithout;
+    int    hitsWith;
+    double without = probe(table, fingerprints, siblings, false, &hitsWithout);
+    double with    = probe(table, fingerprints, siblings, true, &hitsWith);
+    printf("%-28s %9.2f %9.2f %8.2fx %10d\n", name, without, with, without / with, hitsWith);
+    if (hitsWith != hitsWithout)
+        printf("    warning: hit counts differ (%d vs %d)\n", hitsWithout, hitsWith);
+}
+} // anonymous namespace
+
+int main(int argc, char ** argv)
+{
+    size_t sizeMiB  = (argc > 1) ? (size_t)strtoull(argv[1], nullptr, 10) : 1024;
+    size_t siblings = (argc > 2) ? (size_t)strtoull(argv[2], nullptr, 10) : 32;
+    size_t nodes    = (argc > 3) ? (size_t)strtoull(argv[3], nullptr, 10) : 200000;
+    size_t size     = sizeMiB * 1024 * 1024;
+
+    printf("table size = %zu MiB, responses per node = %zu, nodes = %zu\n\n", sizeMiB, siblings, nodes);
+    printf("%-28s %9s %9s %9s %10s\n", "table", "ns/probe", "prefetch", "speedup", "hits");
+
+    {
+        TranspositionTable table(size / 16, 8);
+        run("TranspositionTable", table, size / 16, siblings, nodes);
+    }
+    {
+        RangeEvaluator            sef;
+        CompactTranspositionTable table(size / 8, 8, sef);
+        run("CompactTranspositionTable", table, size / 8, siblings, nodes);
+    }
+
+    return 0;
+}
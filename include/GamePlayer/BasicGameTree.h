@@ -0,0 +1,1348 @@
+#pragma once
+
+#include "GamePlayer/CycleCounter.h"
+#include "GamePlayer/GameState.h"
+#include "GamePlayer/GameTreePolicies.h"
+#include "GamePlayer/MateDistance.h"
+#include "GamePlayer/PathHistory.h"
+#include "GamePlayer/PositionDatabase.h"
+#include "GamePlayer/SearchTrace.h"
+#include "GamePlayer/StaticEvaluator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#if defined(DEBUG_GAME_TREE_NODE_INFO)
+#include <cstdio>
+#endif // defined(DEBUG_GAME_TREE_NODE_INFO)
+
+namespace GamePlayer
+{
+
+//! Time spent in each phase of the search, by the ply of the state being searched
+//!
+//! Times are measured in cycles of readCycleCounter(), whose rate depends on the platform. The total time of the searches is
+//! measured both in cycles and in nanoseconds, so cycles can be converted to time. Times accumulate over searches until reset()
+//! is called.
+struct GameTreePhaseTimes
+{
+    enum Phase
+    {
+        GENERATE,            // Generating responses
+        EVALUATE,            // Static evaluation
+        TRANSPOSITION_TABLE, // T-table probes and updates
+        SORT,                // Sorting responses
+        NUM_PHASES
+    };
+
+    static size_t constexpr MAX_DEPTH = 10; // Maximum number of plies tracked. Deeper plies are included in the last.
+    uint64_t cycles[MAX_DEPTH][NUM_PHASES]; // Total cycles spent in each phase
+    uint64_t counts[MAX_DEPTH][NUM_PHASES]; // Number of times each phase was timed
+    uint64_t searchCycles;                  // Total cycles spent in findBestResponse()
+    uint64_t searchNanoseconds;             // Total time spent in findBestResponse()
+
+    GameTreePhaseTimes();
+    void           reset();
+    void           add(Phase phase, int depth, uint64_t elapsed);
+    nlohmann::json toJson() const;
+};
+
+inline GameTreePhaseTimes::GameTreePhaseTimes()
+{
+    reset();
+}
+
+inline void GameTreePhaseTimes::reset()
+{
+    memset(cycles, 0, sizeof(cycles));
+    memset(counts, 0, sizeof(counts));
+    searchCycles      = 0;
+    searchNanoseconds = 0;
+}
+
+inline void GameTreePhaseTimes::add(Phase phase, int depth, uint64_t elapsed)
+{
+    size_t d = std::min((size_t)depth, MAX_DEPTH - 1);
+    cycles[d][phase] += elapsed;
+    ++counts[d][phase];
+}
+
+inline nlohmann::json GameTreePhaseTimes::toJson() const
+{
+    static char const * const NAMES[NUM_PHASES] = {"generate", "evaluate", "transpositionTable", "sort"};
+
+    nlohmann::json out = {{"searchCycles", searchCycles}, {"searchNanoseconds", searchNanoseconds}};
+    for (int p = 0; p < NUM_PHASES; ++p)
+    {
+        std::vector<uint64_t> c(MAX_DEPTH);
+        std::vector<uint64_t> n(MAX_DEPTH);
+        for (size_t d = 0; d < MAX_DEPTH; ++d)
+        {
+            c[d] = cycles[d][p];
+            n[d] = counts[d][p];
+        }
+        out[NAMES[p]] = {{"cycles", c}, {"counts", n}};
+    }
+    return out;
+}
+
+//! A game tree search implementation using min-max strategy, alpha-beta pruning, and a transposition table.
+//!
+//! The types used by the search and the optional features are selected at compile time by the Policies (see GameTreePolicies.h),
+//! and trees with different configurations can be used in the same program. A feature that is disabled by the policies compiles to
+//! nothing: its code is removed, its data members take no space, and calling its setter is a compile-time error. A feature that is
+//! enabled by the policies must still be enabled at run time by its setter. GameTree is the configuration selected by the build
+//! options.
+//!
+//! The search, its statistics, and its phase times are defined entirely in headers, so any configuration can be instantiated by
+//! its user. Only the components named by the policies or passed to the setters (such as TranspositionTable, SearchTrace and
+//! PositionDatabase) are compiled in the library.
+
+template <typename Policies>
+class BasicGameTree
+{
+public:
+    using TranspositionTable = typename Policies::TranspositionTable;
+    using Evaluator          = typename Policies::Evaluator;
+    using MoveOrdering       = typename Policies::MoveOrdering;
+    using AnalysisData       = typename Policies::Statistics;
+    using PhaseTimes         = GameTreePhaseTimes;
+
+    static_assert(std::is_base_of_v<StaticEvaluator, Evaluator>, "The evaluator must be derived from StaticEvaluator");
+
+    //! Response generator function object type.
+    //! @param  state   state to respond to
+    //! @param  depth   current ply
+    //! @return list of all possible responses
+    //! @note   The caller gains ownership of the returned states.
+    //! @note   Returning no responses simply indicates that neither player can continue. It does not indicate the that game is
+    //!         over or that the player has passed. If passing is allowed, then it must be included in the responses, especially
+    //!         if is the only legal move. Similarly, if the inability to move results a loss, then the loss must be included as a
+    //!         response.
+    using ResponseGenerator = std::function<std::vector<GameState *>(GameState const & state, int depth)>;
+
+    //! Null move generator function object type.
+    //! @param  state   state in which the player to move passes
+    //! @return the state after the player passes, or nullptr if the player may not pass in this state
+    //! @note   The caller gains ownership of the returned state.
+    using NullMoveGenerator = std::function<GameState *(GameState const & state)>;
+
+    //! Constructor.
+    //!
+    //! @param 	tt          A transposition table to be used in a search. The table is assumed to be persistent.
+    //! @param 	sef         The static evaluation function
+    //! @param  rg          The response generator
+    //! @param 	maxDepth    The maximum number of plies to search
+    BasicGameTree(std::shared_ptr<TranspositionTable> tt, std::shared_ptr<Evaluator> sef, ResponseGenerator rg, int maxDepth);
+
+    //! Searches for the best response to the given state.
+    //!
+    //! @param  s0  The current state
+    //!
+    //! @return     The value of s0. The chosen response is returned in s0->response_.
+    float findBestResponse(std::shared_ptr<GameState> & s0) const;
+
+    //! A response and its value
+    struct ScoredResponse
+    {
+        std::shared_ptr<GameState> state;
+        float                      value;
+    };
+
+    //! Searches for the n best responses to the given state (multi-PV).
+    //!
+    //! All responses are searched in one pass, and the values of the returned responses are exact. This is much cheaper than n
+    //! searches, since a response is searched only until it is known that it is not among the n best.
+    //!
+    //! @note   The root is always searched. A position database record holds only the best response, so it is not consulted for
+    //!         s0 (it is still consulted for the responses), and mate-distance pruning does not apply since the window is
+    //!         unbounded.
+    std::vector<ScoredResponse> findBestResponses(std::shared_ptr<GameState> & s0, int n) const;
+
+    //! Sets a database of precomputed results to be consulted before searching a state, or nullptr for none.
+    //!
+    //! A result in the database is used only if its quality is at least as good as the quality of a search of the state.
+    void setPositionDatabase(std::shared_ptr<PositionDatabase> db)
+    {
+        static_assert(Policies::POSITION_DATABASE, "The policies disable the position database");
+        positionDatabase_ = db;
+    }
+
+    //! Enables or disables late move reductions.
+    //!
+    //! Since responses are searched in order of their preliminary values, responses late in the list are rarely chosen. These
+    //! responses are searched to a reduced depth, and searched again at full depth only if the reduced search shows that they
+    //! might be chosen after all.
+    void setLateMoveReductions(int minIndex, int reduction);
+
+    //! Enables or disables null-move pruning.
+    //!
+    //! If a player can pass and the opponent still can't do better than a value that causes a cutoff, then the player's actual
+    //! moves are assumed to cause a cutoff too, and the state is not searched. The search after the pass is done to a reduced
+    //! depth, so this is much cheaper than searching the state. This is only suitable for games in which passing is legal (or at
+    //! least, in which moving is never worse than passing).
+    void setNullMovePruning(NullMoveGenerator nmg, int reduction);
+
+    //! Enables or disables the detection of repeated states.
+    //!
+    //! In games in which a state can occur more than once, a response that repeats a state on the path from the start of the game
+    //! (see setGameHistory()) is scored as a draw instead of being searched. Any value affected by such a draw depends on the path
+    //! taken to the state, so it is not saved in the transposition table.
+    //!
+    //! @param  enabled     True to enable detection
+    //! @param  drawValue   Value of a repeated state (for example, midway between the win values, or biased to avoid draws)
+    void setRepetitionDetection(bool enabled, float drawValue);
+
+    //! Sets the fingerprints of the states preceding the current state in the game, oldest first. These are included in the path
+    //! when repeated states are detected.
+    void setGameHistory(std::vector<uint64_t> history)
+    {
+        static_assert(Policies::REPETITION_DETECTION, "The policies disable repetition detection");
+        gameHistory_ = std::move(history);
+    }
+
+    //! Sets a trace in which the search records the states it visits, or nullptr to stop recording.
+    void setSearchTrace(std::shared_ptr<SearchTrace> trace)
+    {
+        static_assert(Policies::SEARCH_TRACE, "The policies disable the search trace");
+        searchTrace_ = trace;
+    }
+
+    //! Enables or disables timing of the phases of the search. Timing is disabled by default.
+    //!
+    //! When enabled, the time spent in each phase is added to phaseTimes_.
+    void setPhaseTiming(bool enabled)
+    {
+        static_assert(Policies::PHASE_TIMING, "The policies disable phase timing");
+        phaseTiming_ = enabled;
+    }
+
+    //! Returns the maximum number of plies searched
+    int maxDepth() const { return maxDepth_; }
+
+    //! Phase times for the searches since the last reset
+    mutable PhaseTimes phaseTimes_;
+
+    //! Statistics of the searches. The data collected depends on the Statistics policy.
+    mutable AnalysisData analysisData_;
+
+private:
+    struct Node
+    {
+        std::shared_ptr<GameState> state;
+        float                      value;                   // Value of the state
+        int                        quality;                 // Quality of the value
+        bool                       isNullMove      = false; // True if the state is the result of a pass by the null-move search
+        bool                       isPathDependent = false; // True if the value depends on the path to the state
+    };
+    using NodeList = std::vector<Node>;
+
+    // Sets the value of the node to the value of Alice's best response. The search ends 'reduction' plies before the maximum depth.
+    void aliceSearch(Node * node, float alpha, float beta, int depth, int reduction) const;
+
+    // Sets the value of the node to the value of Bob's best response. The search ends 'reduction' plies before the maximum depth.
+    void bobSearch(Node * node, float alpha, float beta, int depth, int reduction) const;
+
+    // Sets the value of the root to the value of its best response and returns its n best responses
+    std::vector<ScoredResponse> multiPvSearch(Node * node, int n) const;
+
+    // Returns true if mate-distance pruning cuts off the search of the node, in which case the node's value is set
+    bool mateDistanceCutoff(Node * node, float alpha, float beta, int depth, int quality) const;
+
+    // Returns true if null-move pruning cuts off the search of the node, in which case the node's value is set
+    bool nullMoveCutoff(Node * node, float alpha, float beta, int depth, int reduction) const;
+
+    // Returns the number of plies by which the search of the i-th response is reduced
+    int lateMoveReduction(int depth, size_t i, int horizon) const;
+
+    // Sets the value and response of the node from the position database. Returns false if the database has no usable result.
+    bool probePositionDatabase(Node * node, int depth) const;
+
+    // Generates a list of responses to the given node
+    NodeList generateResponses(Node const * node, int depth) const;
+
+    // Get the value of the state from the static evaluator or the transposition table. Returns true if it is from the T-table.
+    bool getValue(GameState const & state, uint64_t fingerprint, int depth, float * pValue, int * pQuality) const;
+
+    // Returns the value and quality of a state from the T-table, if the policies use one
+    std::optional<typename TranspositionTable::CheckResult> probeValue(uint64_t fingerprint, int depth) const;
+
+    // Saves the value of a state in the T-table, if the policies use one
+    void saveValue(uint64_t fingerprint, float value, int quality, int ply, int depth) const;
+
+    // Returns true if the change in value from the previous state warrants searching one more ply
+    bool shouldDoQuiescentSearch(float previousValue, float thisValue) const;
+
+    // Adds the time since the start of a search to the phase times
+    void addSearchTime(std::chrono::steady_clock::time_point startTime, uint64_t startCycles) const;
+
+    // Returns the cycle counter if phase timing is enabled, and adds the cycles since 'start' to the phase's time
+    uint64_t phaseStart() const;
+    void     phaseEnd(typename PhaseTimes::Phase phase, int depth, uint64_t start) const;
+
+    // Resets the path to the game history, and adds or removes a node's state at the end of the path, if repetitions are detected
+    void resetPath() const;
+    void pushPath(Node const * node) const;
+    void popPath() const;
+
+    // Returns true if repetitions are detected and the state is on the path
+    bool isRepetition(uint64_t fingerprint) const;
+
+    // Records the beginning and end of the search of a node in the search trace, if there is one
+    void traceEnter(Node const * node, int depth, float alpha, float beta) const;
+    void traceExit(Node const * node, int depth, float alpha, float beta, uint8_t flags) const;
+
+    // Records the beginning and end of the evaluation of a response that is not searched, if there is a search trace
+    void traceLeafEnter(uint64_t fingerprint, int depth) const;
+    void traceLeafExit(Node const * node, int depth, uint8_t flags) const;
+
+#if defined(DEBUG_GAME_TREE_NODE_INFO)
+    void printStateInfo(Node const & state, int depth, float alpha, float beta) const;
+#endif // defined(DEBUG_GAME_TREE_NODE_INFO)
+
+    // Return the objects used by the optional features, or nullptr if a feature is disabled by the policies or at run time
+    PositionDatabase const * positionDatabase() const
+    {
+        if constexpr (Policies::POSITION_DATABASE)
+            return positionDatabase_.get();
+        else
+            return nullptr;
+    }
+    NullMoveGenerator const * nullMoveGenerator() const
+    {
+        if constexpr (Policies::NULL_MOVE_PRUNING)
+            return nullMoveGenerator_ ? &nullMoveGenerator_ : nullptr;
+        else
+            return nullptr;
+    }
+    SearchTrace * searchTrace() const
+    {
+        if constexpr (Policies::SEARCH_TRACE)
+            return searchTrace_.get();
+        else
+            return nullptr;
+    }
+
+    // Return true if a feature is enabled both by the policies and at run time. These are constant if the policies disable the
+    // feature, so the code that uses it is removed.
+    bool usingPositionDatabase() const { return positionDatabase() != nullptr; }
+    bool usingLateMoveReductions() const
+    {
+        if constexpr (Policies::LATE_MOVE_REDUCTIONS)
+            return lateMoveReduction_ > 0;
+        else
+            return false;
+    }
+    bool usingNullMovePruning() const { return nullMoveGenerator() != nullptr; }
+    bool detectingRepetitions() const
+    {
+        if constexpr (Policies::REPETITION_DETECTION)
+            return repetitionDetection_;
+        else
+            return false;
+    }
+    bool tracing() const { return searchTrace() != nullptr; }
+    bool timingPhases() const
+    {
+        if constexpr (Policies::PHASE_TIMING)
+            return phaseTiming_;
+        else
+            return false;
+    }
+
+    static int constexpr SEF_QUALITY = 0;
+
+    // A change in value larger than this fraction of the full range of values triggers a quiescent search
+    static float constexpr QUIESCENT_SEARCH_THRESHOLD = 1.0f / 16.0f;
+
+    // The type of a member that is used only by an optional feature. If the policies disable the feature, the member is empty and,
+    // since it is declared [[no_unique_address]], it takes no space.
+    template <typename T>
+    struct Disabled
+    {
+    };
+    template <bool ENABLED, typename T>
+    using IfEnabled = std::conditional_t<ENABLED, T, Disabled<T>>;
+
+    using PositionDatabaseMember  = IfEnabled<Policies::POSITION_DATABASE, std::shared_ptr<PositionDatabase>>;
+    using NullMoveGeneratorMember = IfEnabled<Policies::NULL_MOVE_PRUNING, NullMoveGenerator>;
+    using SearchTraceMember       = IfEnabled<Policies::SEARCH_TRACE, std::shared_ptr<SearchTrace>>;
+    using GameHistoryMember       = IfEnabled<Policies::REPETITION_DETECTION, std::vector<uint64_t>>;
+    using PathHistoryMember       = IfEnabled<Policies::REPETITION_DETECTION, PathHistory>;
+
+    int                                             maxDepth_;            // How deep to search
+    std::shared_ptr<TranspositionTable>             transpositionTable_;  // Transposition table (persistent)
+    std::shared_ptr<Evaluator>                      staticEvaluator_;     // Static evaluator (persistent)
+    ResponseGenerator                               responseGenerator_;
+    [[no_unique_address]] PositionDatabaseMember    positionDatabase_;    // Precomputed results (optional)
+    int                                             lateMoveMinIndex_;    // Index of the first response that is reduced
+    int                                             lateMoveReduction_;   // Late move reduction in plies (0 if disabled)
+    [[no_unique_address]] NullMoveGeneratorMember   nullMoveGenerator_;   // Generates pass states (optional)
+    int                                             nullMoveReduction_;   // Null move reduction in plies
+    [[no_unique_address]] SearchTraceMember         searchTrace_;         // Records the states visited (optional)
+    bool                                            phaseTiming_;         // True if the phases of the search are timed
+    MateDistance                                    mateDistance_;        // Adjusts win/loss values by their distance
+    bool                                            repetitionDetection_; // True if repeated states are detected
+    float                                           drawValue_;           // Value of a repeated state
+    [[no_unique_address]] GameHistoryMember         gameHistory_;         // States preceding the current state in the game
+    [[no_unique_address]] mutable PathHistoryMember path_;                // States on the path to the state being searched
+};
+
+template <typename Policies>
+BasicGameTree<Policies>::BasicGameTree(std::shared_ptr<TranspositionTable> tt,
+                                       std::shared_ptr<Evaluator>          sef,
+                                       ResponseGenerator                   rg,
+                                       int                                 maxDepth)
+    : maxDepth_(maxDepth)
+    , transpositionTable_(tt)
+    , staticEvaluator_(sef)
+    , responseGenerator_(rg)
+    , lateMoveMinIndex_(0)
+    , lateMoveReduction_(0)
+    , nullMoveReduction_(0)
+    , phaseTiming_(false)
+    , mateDistance_(*sef)
+    , repetitionDetection_(false)
+    , drawValue_(0.0f)
+{
+}
+
+//! @param  minIndex    Responses at this index or later in the sorted list of responses are reduced
+//! @param  reduction   Number of plies by which the search is reduced, or 0 to disable late move reductions
+
+template <typename Policies>
+void BasicGameTree<Policies>::setLateMoveReductions(int minIndex, int reduction)
+{
+    static_assert(Policies::LATE_MOVE_REDUCTIONS, "The policies disable late move reductions");
+    lateMoveMinIndex_  = minIndex;
+    lateMoveReduction_ = reduction;
+}
+
+//! @param  nmg         Returns the state resulting from the player passing, or nullptr if the player may not pass. If nmg is
+//!                     empty, null-move pruning is disabled.
+//! @param  reduction   Number of plies by which the search following a null move is reduced
+
+template <typename Policies>
+void BasicGameTree<Policies>::setNullMovePruning(NullMoveGenerator nmg, int reduction)
+{
+    static_assert(Policies::NULL_MOVE_PRUNING, "The policies disable null-move pruning");
+    nullMoveGenerator_ = nmg;
+    nullMoveReduction_ = reduction;
+}
+
+//! @param  enabled     True to enable detection
+//! @param  drawValue   Value of a repeated state
+
+template <typename Policies>
+void BasicGameTree<Policies>::setRepetitionDetection(bool enabled, float drawValue)
+{
+    static_assert(Policies::REPETITION_DETECTION, "The policies disable repetition detection");
+    repetitionDetection_ = enabled;
+    drawValue_           = drawValue;
+}
+
+template <typename Policies>
+float BasicGameTree<Policies>::findBestResponse(std::shared_ptr<GameState> & s0) const
+{
+    Node root{s0};
+
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t                              startCycles = 0;
+    if (timingPhases())
+    {
+        startTime   = std::chrono::steady_clock::now();
+        startCycles = readCycleCounter();
+    }
+
+    resetPath();
+
+    if (s0->whoseTurn() == GameState::PlayerId::ALICE)
+        aliceSearch(&root, -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), 0, 0);
+    else
+        bobSearch(&root, -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), 0, 0);
+
+    if (timingPhases())
+        addSearchTime(startTime, startCycles);
+
+    analysisData_.onSearchDone(root.value);
+
+    return root.value;
+}
+
+//! @param  s0  The current state
+//! @param  n   The number of responses to return
+//!
+//! @return     The n best responses (or all of them if there are fewer) and their values, best first. The best response is also
+//!             returned in s0->response_.
+
+template <typename Policies>
+std::vector<typename BasicGameTree<Policies>::ScoredResponse> BasicGameTree<Policies>::findBestResponses(
+    std::shared_ptr<GameState> & s0,
+    int                          n) const
+{
+    Node root{s0};
+
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t                              startCycles = 0;
+    if (timingPhases())
+    {
+        startTime   = std::chrono::steady_clock::now();
+        startCycles = readCycleCounter();
+    }
+
+    resetPath();
+
+    std::vector<ScoredResponse> best = multiPvSearch(&root, n);
+
+    if (timingPhases())
+        addSearchTime(startTime, startCycles);
+
+    analysisData_.onSearchDone(root.value);
+
+    return best;
+}
+
+// Searches the root for its n best responses in a single pass.
+//
+// The values of the responses must be exact, so the usual alpha-beta window at the root can't be used. Instead, each response is
+// searched with a window that excludes only the values that can't make the list: once n responses have been found, a response is
+// searched with the n-th best value as its bound. If its value passes the bound, then the value is exact and it replaces the n-th
+// best. Otherwise, it is cut off as soon as that is known. The responses are searched in order of their preliminary values, so the
+// bound is usually tight early, and the searches of all the responses share the T-table.
+//
+// Unlike aliceSearch() and bobSearch(), the root is not looked up in the position database, since a record gives the value of only
+// the best response, and there is no mate-distance check, since nothing can be cut off with an unbounded window.
+
+template <typename Policies>
+std::vector<typename BasicGameTree<Policies>::ScoredResponse> BasicGameTree<Policies>::multiPvSearch(Node * node, int n) const
+{
+    bool aliceToMove        = (node->state->whoseTurn() == GameState::PlayerId::ALICE);
+    int  depth              = 0;
+    int  responseDepth      = depth + 1;
+    int  minResponseQuality = maxDepth_ - responseDepth; // Minimum acceptable quality of responses to this state
+
+    // Returns true if value a is better than value b for the player to move
+    auto better = [aliceToMove](float a, float b) { return aliceToMove ? (a > b) : (a < b); };
+
+    traceEnter(node, depth, -std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    pushPath(node);
+
+    std::vector<ScoredResponse> best;
+    NodeList                    responses = generateResponses(node, depth);
+    if (responses.empty() || n <= 0)
+    {
+        popPath();
+        traceExit(node, depth, -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), SearchTrace::NO_RESPONSES);
+        return best;
+    }
+
+    uint64_t sortStart = phaseStart();
+    MoveOrdering::sort(responses, aliceToMove);
+    phaseEnd(PhaseTimes::SORT, depth, sortStart);
+
+    for (Node & response : responses)
+    {
+        // Only values better than the n-th best so far can make the list
+        float bound = ((int)best.size() < n) ? (aliceToMove ? -std::numeric_limits<float>::max() : std::numeric_limits<float>::max())
+                                              : best.back().value;
+
+        // Search the response unless the game is over or its value is already good enough
+        bool gameOver = aliceToMove ? mateDistance_.isAliceWin(response.value) : mateDistance_.isBobWin(response.value);
+        if (!gameOver && (response.quality < minResponseQuality) &&
+            ((responseDepth < maxDepth_) ||
+             (shouldDoQuiescentSearch(node->value, response.value) && (responseDepth < maxDepth_ + 1))))
+        {
+            if (aliceToMove)
+                bobSearch(&response, bound, std::numeric_limits<float>::max(), responseDepth, 0);
+            else
+                aliceSearch(&response, -std::numeric_limits<float>::max(), bound, responseDepth, 0);
+        }
+        node->isPathDependent = node->isPathDependent || response.isPathDependent;
+#if defined(DEBUG_GAME_TREE_NODE_INFO)
+        printStateInfo(response,
+                       depth,
+                       aliceToMove ? bound : -std::numeric_limits<float>::max(),
+                       aliceToMove ? std::numeric_limits<float>::max() : bound);
+#endif // defined(DEBUG_GAME_TREE_NODE_INFO)
+
+        // If the value is better than the bound, then it is exact, and the response replaces the n-th best
+        if ((int)best.size() < n || better(response.value, bound))
+        {
+            auto position = std::find_if(
+                best.begin(), best.end(), [&](ScoredResponse const & r) { return better(response.value, r.value); });
+            best.insert(position, ScoredResponse{response.state, response.value});
+            if ((int)best.size() > n)
+                best.pop_back();
+        }
+    }
+
+    popPath();
+
+    // The best value is exact, so it is saved in the T-table (unless it depends on the path)
+    node->value            = best.front().value;
+    node->quality          = maxDepth_ - depth;
+    node->state->response_ = best.front().state;
+    if (!node->isPathDependent)
+    {
+        saveValue(node->state->cachedFingerprint(), node->value, node->quality, depth, depth);
+    }
+
+    traceExit(node, depth, -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), 0);
+    return best;
+}
+
+// Evaluate all of Alice's possible responses to the given state. The chosen response is the one with the highest value. The value
+// in the node is overwritten by the resulting value of the search.
+
+template <typename Policies>
+void BasicGameTree<Policies>::aliceSearch(Node * node, float alpha, float beta, int depth, int reduction) const
+{
+    int horizon       = maxDepth_ - reduction;        // Depth at which the search of this state ends
+    int responseDepth = depth + 1;                    // Depth of responses to this state
+    int quality       = horizon - depth;              // Quality of values at this depth (this is the depth of plies searched to
+                                                      // get the results for this ply)
+    int minResponseQuality = horizon - responseDepth; // Minimum acceptable quality of responses to this state
+    float const originalAlpha = alpha;                // Alpha before it is raised by the responses
+
+    traceEnter(node, depth, alpha, beta);
+
+    // If no win or loss from here can fall within the window, then there is no need to search
+    if (mateDistanceCutoff(node, alpha, beta, depth, quality))
+    {
+        traceExit(node, depth, alpha, beta, (node->value < alpha) ? SearchTrace::ALPHA_CUTOFF : SearchTrace::BETA_CUTOFF);
+        return;
+    }
+
+    // If the result is already known, then there is no need to search
+    if (usingPositionDatabase() && probePositionDatabase(node, depth))
+    {
+        traceExit(node, depth, alpha, beta, SearchTrace::DATABASE_HIT);
+        return;
+    }
+
+    // The state is on the path while its responses are searched
+    pushPath(node);
+
+    // If passing is still good enough to cause a cutoff, then there is no need to search
+    if (usingNullMovePruning() && nullMoveCutoff(node, alpha, beta, depth, reduction))
+    {
+        popPath();
+        traceExit(node, depth, alpha, beta, SearchTrace::NULL_MOVE_CUTOFF);
+        return;
+    }
+
+    // Generate a list of the possible responses to this state. They are sorted in descending order hoping that a beta cutoff will
+    // occur early.
+    // Note: Preliminary values of the generated states are retrieved from the transposition table or computed by the static
+    // evaluation function.
+    NodeList responses = generateResponses(node, depth);
+
+    // If there are no responses, it can be assumed that the game is over and the value is the value of the current state. Return
+    // without assigning a response.
+    // Note: There are games in which the inability to move means that the player has lost, but that is not supported here. It must
+    // be handled elsewhere or perhaps by generating and evaluating a "pass" response.
+    if (responses.empty())
+    {
+        popPath();
+        traceExit(node, depth, alpha, beta, SearchTrace::NO_RESPONSES);
+        return;
+    }
+
+    // Sort from best to worst for Alice
+    uint64_t sortStart = phaseStart();
+    MoveOrdering::sort(responses, true);
+    phaseEnd(PhaseTimes::SORT, depth, sortStart);
+
+    // Evaluate each of the responses and choose the one with the highest value
+    Node bestResponse{nullptr, -std::numeric_limits<float>::max()};
+    bool pruned = false;
+    for (size_t i = 0; i < responses.size(); ++i)
+    {
+        Node & response = responses[i];
+
+        // If the game is not over, then let's see how Bob responds (updating the value of this response)
+        if (!mateDistance_.isAliceWin(response.value))
+        {
+            // The quality of a value is basically the depth of the search tree below it. The reason for checking the quality is
+            // that some of the responses have not been fully searched. If the quality of the preliminary value is not as good as
+            // the minimum quality and we haven't reached the maximum depth, then do a search. Otherwise, the response's quality is
+            // as good as the quality of a search, so use the response as is.
+            if ((response.quality < minResponseQuality) &&
+                ((responseDepth < horizon) ||
+                 (shouldDoQuiescentSearch(node->value, response.value) && (responseDepth < horizon + 1))))
+            {
+                // Update the value of this response by searching Bob's responses to this response.
+                // Note: If no further search is possible, then the response's value and quality is already set by the static
+                // evaluation and response.state.response_ is left as nullptr.
+                int lmr = lateMoveReduction(depth, i, horizon);
+                if (lmr > 0)
+                {
+                    // Late move reduction: Responses late in the list are unlikely to be chosen, so they are searched less deeply.
+                    // If the reduced search shows that the response might be better than the best so far, it is searched again at
+                    // full depth.
+                    bobSearch(&response, alpha, beta, responseDepth, reduction + lmr);
+                    if (response.value > alpha)
+                    {
+                        analysisData_.onLateMoveResearch();
+                        bobSearch(&response, alpha, beta, responseDepth, reduction);
+                    }
+                }
+                else
+                {
+                    bobSearch(&response, alpha, beta, responseDepth, reduction);
+                }
+            }
+        }
+
+        // If the response's value depends on the path, then so does this state's value
+        node->isPathDependent = node->isPathDependent || response.isPathDependent;
+#if defined(DEBUG_GAME_TREE_NODE_INFO)
+        printStateInfo(response, depth, alpha, beta);
+#endif // defined(DEBUG_GAME_TREE_NODE_INFO)
+
+        // Determine if this response's value is the best so far. If so, then save the value and do alpha-beta pruning
+        if (response.value > bestResponse.value)
+        {
+            // Save it
+            bestResponse = response;
+
+            // If Alice wins with this response, then there is no reason to look for anything better
+            if (bestResponse.value >= mateDistance_.aliceWinsIn(responseDepth))
+                break;
+
+            // alpha-beta pruning (beta cutoff) Here's how it works:
+            //
+            // The bob is looking for the lowest value. The 'beta' is the value of Bob's best move found so far in the previous
+            // ply. If the value of this response is higher than the beta, then Bob will abandon its move leading to this response
+            // because because the result is worse than the result of a move it has already found. As such, there is no reason to
+            // continue.
+
+            if (bestResponse.value > beta)
+            {
+                // Beta cutoff
+                pruned = true;
+                analysisData_.onBetaCutoff();
+                break;
+            }
+
+            // alpha-beta pruning (alpha) Here's how it works:
+            //
+            // Alice is looking for the highest value. The 'alpha' is the value of Alice's best move found so far. If the value of
+            // this response is higher than the alpha, then obviously it is a better move for Alice. The alpha is subsequently
+            // passed to Bob's search so that if it finds a response with a lower value than the alpha, it won't bother continuing
+            // because it knows that Alice already has a better move and will choose it instead of allowing Bob to make a move with
+            // a lower value.
+
+            if (bestResponse.value > alpha)
+                alpha = bestResponse.value;
+        }
+    }
+
+    popPath();
+
+    // Update the value of this state
+
+    node->value            = bestResponse.value;
+    node->quality          = quality;
+    node->state->response_ = bestResponse.state;
+
+    // Save the value of the state in the T-table if the ply was not pruned. Pruning results in an incorrect value because the
+    // search was interrupted. The value is also incorrect if it is outside of the window, because then the responses may have been
+    // pruned, and it is not saved if it depends on the path to the state. Also, note that the value is stored only if its quality is
+    // better than the quality of the value in the table.
+    if (!pruned && !(node->value < originalAlpha) && !node->isPathDependent)
+    {
+        saveValue(node->state->cachedFingerprint(), node->value, node->quality, depth, depth);
+    }
+
+    traceExit(node, depth, alpha, beta, pruned ? SearchTrace::BETA_CUTOFF : 0);
+
+    // Note: all generated states created for this ply, except the the chosen response, are released at this point.
+}
+
+// Evaluate all of Bob's possible responses to the given state. The chosen response is the one with the lowest value. The value in
+// the node is overwritten by the resulting value of the search.
+
+template <typename Policies>
+void BasicGameTree<Policies>::bobSearch(Node * node, float alpha, float beta, int depth, int reduction) const
+{
+    int horizon       = maxDepth_ - reduction;        // Depth at which the search of this state ends
+    int responseDepth = depth + 1;                    // Depth of responses to this state
+    int quality       = horizon - depth;              // Quality of values at this depth (this is the depth of plies searched to
+                                                      // get the results for this ply)
+    int minResponseQuality = horizon - responseDepth; // Minimum acceptable quality of responses to this state
+    float const originalBeta = beta;                  // Beta before it is lowered by the responses
+
+    traceEnter(node, depth, alpha, beta);
+
+    // If no win or loss from here can fall within the window, then there is no need to search
+    if (mateDistanceCutoff(node, alpha, beta, depth, quality))
+    {
+        traceExit(node, depth, alpha, beta, (node->value < alpha) ? SearchTrace::ALPHA_CUTOFF : SearchTrace::BETA_CUTOFF);
+        return;
+    }
+
+    // If the result is already known, then there is no need to search
+    if (usingPositionDatabase() && probePositionDatabase(node, depth))
+    {
+        traceExit(node, depth, alpha, beta, SearchTrace::DATABASE_HIT);
+        return;
+    }
+
+    // The state is on the path while its responses are searched
+    pushPath(node);
+
+    // If passing is still good enough to cause a cutoff, then there is no need to search
+    if (usingNullMovePruning() && nullMoveCutoff(node, alpha, beta, depth, reduction))
+    {
+        popPath();
+        traceExit(node, depth, alpha, beta, SearchTrace::NULL_MOVE_CUTOFF);
+        return;
+    }
+
+    // Generate a list of the possible responses to this state. They are sorted in ascending order hoping that a alpha cutoff will
+    // occur early.
+    // Note: Preliminary values of the generated states are retrieved from the transposition table or computed by the static
+    // evaluation function.
+    NodeList responses = generateResponses(node, depth);
+
+    // If there are no responses, it can be assumed that the game is over and the value is the value of the current state. Return
+    // without assigning a response.
+    // Note: There are games in which the inability to move means that the player has lost, but that is not supported here. It must
+    // be handled elsewhere or perhaps by generating and evaluating a "pass" response.
+    if (responses.empty())
+    {
+        popPath();
+        traceExit(node, depth, alpha, beta, SearchTrace::NO_RESPONSES);
+        return;
+    }
+
+    // Sort from best to worst for Bob
+    uint64_t sortStart = phaseStart();
+    MoveOrdering::sort(responses, false);
+    phaseEnd(PhaseTimes::SORT, depth, sortStart);
+
+    // Evaluate each of the responses and choose the one with the lowest value
+    Node bestResponse{nullptr, std::numeric_limits<float>::max()};
+    bool pruned = false;
+    for (size_t i = 0; i < responses.size(); ++i)
+    {
+        Node & response = responses[i];
+
+        // If the game is not over, then let's see how Alice responds (updating the value of this response)
+        if (!mateDistance_.isBobWin(response.value))
+        {
+            // The quality of a value is basically the depth of the search tree below it. The reason for checking the quality is
+            // that some of the responses have not been fully searched. If the quality of the preliminary value is not as good as
+            // the minimum quality and we haven't reached the maximum depth, then do a search. Otherwise, the response's quality is
+            // as good as the quality of a search, so use the response as is.
+            if ((response.quality < minResponseQuality) &&
+                ((responseDepth < horizon) ||
+                 (shouldDoQuiescentSearch(node->value, response.value) && (responseDepth < horizon + 1))))
+            {
+                // Update the value of this response by searching Alice's responses to this response.
+                // Note: If no further search is possible, then the response's value and quality is already set by the static
+                // evaluation and response.state.response_ is left as nullptr.
+                int lmr = lateMoveReduction(depth, i, horizon);
+                if (lmr > 0)
+                {
+                    // Late move reduction: Responses late in the list are unlikely to be chosen, so they are searched less deeply.
+                    // If the reduced search shows that the response might be better than the best so far, it is searched again at
+                    // full depth.
+                    aliceSearch(&response, alpha, beta, responseDepth, reduction + lmr);
+                    if (response.value < beta)
+                    {
+                        analysisData_.onLateMoveResearch();
+                        aliceSearch(&response, alpha, beta, responseDepth, reduction);
+                    }
+                }
+                else
+                {
+                    aliceSearch(&response, alpha, beta, responseDepth, reduction);
+                }
+            }
+        }
+
+        // If the response's value depends on the path, then so does this state's value
+        node->isPathDependent = node->isPathDependent || response.isPathDependent;
+#if defined(DEBUG_GAME_TREE_NODE_INFO)
+        printStateInfo(response, depth, alpha, beta);
+#endif // defined(DEBUG_GAME_TREE_NODE_INFO)
+
+        // Determine if this response's value is the best so far. If so, then save the value and do alpha-beta pruning
+        if (response.value < bestResponse.value)
+        {
+            // Save it
+            bestResponse = response;
+
+            // If Bob wins with this response, then there is no reason to look for anything better
+            if (bestResponse.value <= mateDistance_.bobWinsIn(responseDepth))
+                break;
+
+            // alpha-beta pruning (alpha cutoff) Here's how it works:
+            //
+            // Alice is looking for the highest value. The 'alpha' is the value of Alice's best move found so far in the previous
+            // ply. If the value of this response is lower than the alpha, then Alice will abandon its move leading to this
+            // response because because the result is worse than the result of a move it has already found. As such, there is no
+            // reason to continue.
+
+            if (bestResponse.value < alpha)
+            {
+                // Alpha cutoff
+                pruned = true;
+                analysisData_.onAlphaCutoff();
+                break;
+            }
+
+            // alpha-beta pruning (beta) Here's how it works.
+            //
+            // Bob is looking for the lowest value. The 'beta' is the value of Bob's best move found so far. If the value of this
+            // response is lower than the beta, then obviously it is a better move for Bob. The beta is subsequently passed to
+            // Alice's search so that if it finds a response with a higher value than the beta, it won't bother continuing because
+            // it knows that Bob already has a better move and will choose it instead of allowing Alice to make a move with a
+            // higher value.
+
+            if (bestResponse.value < beta)
+                beta = bestResponse.value;
+        }
+    }
+
+    popPath();
+
+    // Update the value of this state
+
+    node->value            = bestResponse.value;
+    node->quality          = quality;
+    node->state->response_ = bestResponse.state;
+
+    // Save the value of the state in the T-table if the ply was not pruned. Pruning results in an incorrect value because the
+    // search was interrupted. The value is also incorrect if it is outside of the window, because then the responses may have been
+    // pruned, and it is not saved if it depends on the path to the state. Also, note that the value is stored only if its quality is
+    // better than the quality of the value in the table.
+    if (!pruned && !(node->value > originalBeta) && !node->isPathDependent)
+    {
+        saveValue(node->state->cachedFingerprint(), node->value, node->quality, depth, depth);
+    }
+
+    traceExit(node, depth, alpha, beta, pruned ? SearchTrace::ALPHA_CUTOFF : 0);
+
+    // Note: all generated states created for this ply, except the the chosen response, are released at this point.
+}
+
+// Mate-distance pruning: The best that either player can do from a state is to win with the next move. If even that can't bring the
+// value into the window, then the state is pruned. This cuts off the subtrees that can't beat a shorter win that has already been
+// found. Returns true if the state was pruned, in which case the value of the node has been set.
+
+template <typename Policies>
+bool BasicGameTree<Policies>::mateDistanceCutoff(Node * node, float alpha, float beta, int depth, int quality) const
+{
+    float best  = mateDistance_.aliceWinsIn(depth + 1); // Highest possible value
+    float worst = mateDistance_.bobWinsIn(depth + 1);   // Lowest possible value
+    if (best >= alpha && worst <= beta)
+        return false;
+
+    analysisData_.onMateDistanceCutoff();
+
+    // The value is only a bound, so it is not saved in the T-table
+    node->value   = (best < alpha) ? best : worst;
+    node->quality = quality;
+    return true;
+}
+
+// Null-move pruning: If the player to move could pass and the result of a reduced search is still good enough to cause a cutoff,
+// then it is assumed that one of the player's actual moves would cause a cutoff too, so the state is not searched. Returns true if
+// the state was pruned, in which case the value of the node has been set.
+
+template <typename Policies>
+bool BasicGameTree<Policies>::nullMoveCutoff(Node * node, float alpha, float beta, int depth, int reduction) const
+{
+    // Null-move pruning is not done at the root (a response is needed) or immediately after another null move
+    if (depth == 0 || node->isNullMove)
+        return false;
+
+    // The reduced search must search past the null move
+    int nullReduction = reduction + nullMoveReduction_;
+    if (depth + 1 >= maxDepth_ - nullReduction)
+        return false;
+
+    // A cutoff is impossible if the window is open
+    bool aliceToMove = (node->state->whoseTurn() == GameState::PlayerId::ALICE);
+    if (aliceToMove ? (beta == std::numeric_limits<float>::max()) : (alpha == -std::numeric_limits<float>::max()))
+        return false;
+
+    // If passing is not allowed in this state, then there is no null move
+    GameState * pass = (*nullMoveGenerator())(*node->state);
+    if (!pass)
+        return false;
+
+    Node nullNode{std::shared_ptr<GameState>(pass), node->value, SEF_QUALITY, true};
+    if (aliceToMove)
+    {
+        bobSearch(&nullNode, alpha, beta, depth + 1, nullReduction);
+        node->isPathDependent = node->isPathDependent || nullNode.isPathDependent;
+        if (nullNode.value <= beta)
+            return false;
+    }
+    else
+    {
+        aliceSearch(&nullNode, alpha, beta, depth + 1, nullReduction);
+        node->isPathDependent = node->isPathDependent || nullNode.isPathDependent;
+        if (nullNode.value >= alpha)
+            return false;
+    }
+
+    analysisData_.onNullMoveCutoff();
+
+    // The value is only a bound, so it is not saved in the T-table
+    node->value   = nullNode.value;
+    node->quality = maxDepth_ - reduction - depth;
+    return true;
+}
+
+// Returns the number of plies by which the search of the i-th response (in sorted order) is reduced.
+
+template <typename Policies>
+int BasicGameTree<Policies>::lateMoveReduction(int depth, size_t i, int horizon) const
+{
+    // Responses to the root are not reduced because their values are the result of the search. Otherwise, a response is reduced
+    // only if it is late enough in the list and the reduced search would still search past it.
+    if (!usingLateMoveReductions() || depth == 0 || (int)i < lateMoveMinIndex_ || depth + 1 + lateMoveReduction_ >= horizon)
+        return 0;
+
+    analysisData_.onLateMoveReduction();
+    return lateMoveReduction_;
+}
+
+template <typename Policies>
+bool BasicGameTree<Policies>::probePositionDatabase(Node * node, int depth) const
+{
+    std::optional<PositionDatabase::Record> record = positionDatabase()->find(node->state->cachedFingerprint());
+
+    // The result is usable only if it is at least as good as the result of a search
+    if (!record || record->quality < maxDepth_ - depth)
+        return false;
+
+    // The response is needed only at the root, where it is the result of the search. Since the database only stores the response's
+    // fingerprint, the response itself must be regenerated. If it can't be found, then just search normally.
+    if (depth == 0)
+    {
+        if (record->response == 0)
+            return false;
+
+        std::vector<GameState *>   responses = responseGenerator_(*node->state, depth);
+        std::shared_ptr<GameState> chosen;
+        for (GameState * response : responses)
+        {
+            if (!chosen && response->cachedFingerprint() == record->response)
+                chosen.reset(response);
+            else
+                delete response;
+        }
+        if (!chosen)
+            return false;
+        node->state->response_ = chosen;
+    }
+
+    analysisData_.onDatabaseHit();
+
+    node->value   = mateDistance_.toSearch(record->value, depth);
+    node->quality = record->quality;
+    return true;
+}
+
+template <typename Policies>
+typename BasicGameTree<Policies>::NodeList BasicGameTree<Policies>::generateResponses(Node const * node, int depth) const
+{
+    uint64_t                 generateStart = phaseStart();
+    std::vector<GameState *> responses     = responseGenerator_(*node->state, depth);
+    phaseEnd(PhaseTimes::GENERATE, depth, generateStart);
+
+    analysisData_.onGenerated(depth, responses.size());
+
+    // Prefetch the T-table entries of all the responses before probing any of them so that the latencies of the memory accesses
+    // overlap instead of being paid one at a time.
+    std::vector<uint64_t> fingerprints(responses.size());
+    for (size_t i = 0; i < responses.size(); ++i)
+    {
+        fingerprints[i] = responses[i]->cachedFingerprint();
+        if constexpr (Policies::TRANSPOSITION_TABLE_LOOKUPS)
+            transpositionTable_->prefetch(fingerprints[i]);
+    }
+
+    NodeList rv;
+    rv.reserve(responses.size());
+
+    // Create a list of response nodes. The evaluation of each response is traced as a leaf, since most of them (including all of
+    // them at the horizon) are not searched.
+    for (size_t i = 0; i < responses.size(); ++i)
+    {
+        traceLeafEnter(fingerprints[i], depth + 1);
+
+        // A response that repeats a state on the path is a draw. It is not searched, and its value depends on the path.
+        if (isRepetition(fingerprints[i]))
+        {
+            analysisData_.onRepetition();
+            rv.push_back(Node{std::shared_ptr<GameState>(responses[i]), drawValue_, maxDepth_, false, true});
+            traceLeafExit(&rv.back(), depth + 1, 0);
+            continue;
+        }
+
+        float value;
+        int   quality;
+        bool  found = getValue(*responses[i], fingerprints[i], depth, &value, &quality);
+        rv.push_back(Node{std::shared_ptr<GameState>(responses[i]), value, quality});
+        traceLeafExit(&rv.back(), depth + 1, found ? SearchTrace::TT_HIT : 0);
+    }
+
+    return rv;
+}
+
+template <typename Policies>
+bool BasicGameTree<Policies>::getValue(GameState const & state,
+                                       uint64_t          fingerprint,
+                                       int               depth,
+                                       float *           pValue,
+                                       int *             pQuality) const
+{
+    // SEF optimization:
+    //
+    // Since any value of any state in the T-table has already been computed by search and/or SEF, it has a quality that is at
+    // least as good as the quality of the value returned by the SEF. So, if the state being evaluated is in the T-table, then the
+    // value in the T-table is used instead of running the SEF because T-table lookup is so much faster than the SEF.
+
+    // If it is in the T-table then use that value, otherwise compute the value using SEF.
+    std::optional<typename TranspositionTable::CheckResult> result = probeValue(fingerprint, depth);
+    if (result)
+    {
+        *pValue   = mateDistance_.toSearch(result->first, depth + 1);
+        *pQuality = result->second;
+        return true;
+    }
+
+    analysisData_.onEvaluated(depth);
+
+    uint64_t evaluateStart = phaseStart();
+    float    value         = staticEvaluator_->evaluate(state);
+    phaseEnd(PhaseTimes::EVALUATE, depth, evaluateStart);
+
+    // Note: The state is a response, so it is one ply deeper than 'depth'
+    *pValue   = mateDistance_.toSearch(value, depth + 1);
+    *pQuality = SEF_QUALITY;
+
+    // Save the value of the state in the T-table
+    saveValue(fingerprint, *pValue, *pQuality, depth + 1, depth);
+    return false;
+}
+
+template <typename Policies>
+std::optional<typename BasicGameTree<Policies>::TranspositionTable::CheckResult> BasicGameTree<Policies>::probeValue(
+    uint64_t fingerprint,
+    int      depth) const
+{
+    if constexpr (Policies::TRANSPOSITION_TABLE_LOOKUPS)
+    {
+        uint64_t probeStart = phaseStart();
+        auto     result     = transpositionTable_->check(fingerprint);
+        phaseEnd(PhaseTimes::TRANSPOSITION_TABLE, depth, probeStart);
+        return result;
+    }
+    else
+    {
+        (void)fingerprint;
+        (void)depth;
+        return std::nullopt;
+    }
+}
+
+//! @param  fingerprint     Fingerprint of the state
+//! @param  value           Value of the state in the search
+//! @param  quality         Quality of the value
+//! @param  ply             Distance of the state from the root, used to convert the value for the table
+//! @param  depth           Ply of the state being searched, used for the phase times
+
+template <typename Policies>
+void BasicGameTree<Policies>::saveValue(uint64_t fingerprint, float value, int quality, int ply, int depth) const
+{
+    if constexpr (Policies::TRANSPOSITION_TABLE_LOOKUPS)
+    {
+        uint64_t updateStart = phaseStart();
+        transpositionTable_->update(fingerprint, mateDistance_.toTable(value, ply), quality);
+        phaseEnd(PhaseTimes::TRANSPOSITION_TABLE, depth, updateStart);
+    }
+    else
+    {
+        (void)fingerprint;
+        (void)value;
+        (void)quality;
+        (void)ply;
+        (void)depth;
+    }
+}
+
+template <typename Policies>
+void BasicGameTree<Policies>::addSearchTime(std::chrono::steady_clock::time_point startTime,
+                                            uint64_t                              startCycles) const
+{
+    phaseTimes_.searchCycles += readCycleCounter() - startCycles;
+    phaseTimes_.searchNanoseconds +=
+        (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+template <typename Policies>
+uint64_t BasicGameTree<Policies>::phaseStart() const
+{
+    return timingPhases() ? readCycleCounter() : 0;
+}
+
+template <typename Policies>
+void BasicGameTree<Policies>::phaseEnd(typename PhaseTimes::Phase phase, int depth, uint64_t start) const
+{
+    if (timingPhases())
+        phaseTimes_.add(phase, depth, readCycleCounter() - start);
+}
+
+template <typename Policies>
+void BasicGameTree<Policies>::resetPath() const
+{
+    if constexpr (Policies::REPETITION_DETECTION)
+    {
+        if (!detectingRepetitions())
+            return;
+
+        path_.clear();
+        for (uint64_t fingerprint : gameHistory_)
+        {
+            path_.push(fingerprint);
+        }
+    }
+}
+
+template <typename Policies>
+void BasicGameTree<Policies>::pushPath(Node const * node) const
+{
+    if constexpr (Policies::REPETITION_DETECTION)
+    {
+        if (detectingRepetitions())
+            path_.push(node->state->cachedFingerprint());
+    }
+    else
+    {
+        (void)node;
+    }
+}
+
+template <typename Policies>
+void BasicGameTree<Policies>::popPath() const
+{
+    if constexpr (Policies::REPETITION_DETECTION)
+    {
+        if (detectingRepetitions())
+            path_.pop();
+    }
+}
+
+template <typename Policies>
+bool BasicGameTree<Policies>::isRepetition(uint64_t fingerprint) const
+{
+    if constexpr (Policies::REPETITION_DETECTION)
+    {
+        return detectingRepetitions() && path_.contains(fingerprint);
+    }
+    else
+    {
+        (void)fingerprint;
+        return false;
+    }
+}
+
+template <typename Policies>
+void BasicGameTree<Policies>::traceEnter(Node const * node, int depth, float alpha, float beta) const
+{
+    if (tracing())
+        searchTrace()->enter(node->state->cachedFingerprint(), depth, alpha, beta);
+}
+
+template <typename Policies>
+void BasicGameTree<Policies>::traceExit(Node const * node, int depth, float alpha, float beta, uint8_t flags) const
+{
+    if (tracing())
+        searchTrace()->exit(node->state->cachedFingerprint(), depth, alpha, beta, node->value, node->quality, flags);
+}
+
+template <typename Policies>
+void BasicGameTree<Policies>::traceLeafEnter(uint64_t fingerprint, int depth) const
+{
+    if (tracing())
+    {
+        searchTrace()->enter(
+            fingerprint, depth, -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), SearchTrace::LEAF);
+    }
+}
+
+template <typename Policies>
+void BasicGameTree<Policies>::traceLeafExit(Node const * node, int depth, uint8_t flags) const
+{
+    if (tracing())
+    {
+        searchTrace()->exit(node->state->cachedFingerprint(),
+                           depth,
+                           -std::numeric_limits<float>::max(),
+                           std::numeric_limits<float>::max(),
+                           node->value,
+                           node->quality,
+                           flags | SearchTrace::LEAF);
+    }
+}
+
+template <typename Policies>
+bool BasicGameTree<Policies>::shouldDoQuiescentSearch(float previousValue, float thisValue) const
+{
+    if constexpr (Policies::QUIESCENT_SEARCH)
+    {
+        // In search of quiescence. If the value changes by a large amount, then the position is probably not stable and should be
+        // searched one more ply.
+        float const range = staticEvaluator_->aliceWinsValue() - staticEvaluator_->bobWinsValue();
+        return std::abs(thisValue - previousValue) > range * QUIESCENT_SEARCH_THRESHOLD;
+    }
+    else
+    {
+        (void)previousValue;
+        (void)thisValue;
+        return false;
+    }
+}
+
+#if defined(DEBUG_GAME_TREE_NODE_INFO)
+template <typename Policies>
+void BasicGameTree<Policies>::printStateInfo(Node const & node, int depth, float alpha, float beta) const
+{
+    for (int i = 0; i < depth; ++i)
+    {
+        fprintf(stderr, "%-2d  ", i);
+    }
+
+    uint64_t const fingerprint = node.state->cachedFingerprint();
+    fprintf(stderr, "f = 0x%08llx, value = %6.2f, quality = %3d, ", fingerprint & 0xffffffff, node.value, node.quality);
+    if (alpha == -std::numeric_limits<float>::max())
+        fprintf(stderr, "alpha = -∞, ");
+    else
+        fprintf(stderr, "alpha = %6.2f, ", alpha);
+    if (beta == std::numeric_limits<float>::max())
+        fprintf(stderr, "beta = ∞\n");
+    else
+        fprintf(stderr, "beta = %6.2f\n", beta);
+}
+
+#endif // defined(DEBUG_GAME_TREE_NODE_INFO)
+
+} // namespace GamePlayer
@@ -0,0 +1,157 @@
+#pragma once
+
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+#include <nlohmann/json_fwd.hpp>
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+#include "GamePlayer/MateDistance.h"
+#include "GamePlayer/Prefetch.h"
+#include "GamePlayer/TableSizing.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace GamePlayer
+{
+class StaticEvaluator;
+
+//! A memory-dense alternative to TranspositionTable.
+//!
+//! The interface and replacement policy are the same as TranspositionTable's, but each entry is packed into 8 bytes instead of
+//! 16, so twice as many entries fit in the same amount of memory. The density is obtained by giving up some precision:
+//!
+//! - Only the upper 32 bits of the fingerprint are stored. The slot the entry occupies implies the fingerprint modulo the size,
+//!   which for a table of 2^k entries is the lower k bits. The effective key is therefore 32 + k bits wide (for example, 52 bits
+//!   for a table of 2^20 entries), and bits k through 31 are neither stored nor implied. A false match is less likely than a
+//!   collision in a 32-bit hash, but more likely than with the full fingerprint.
+//! - The value is quantized to 16 bits over the range [bobWinsValue(), aliceWinsValue()] of the static evaluator. Win/loss values
+//!   (see MateDistance) are preserved exactly, and any other value is reproduced to within maxQuantizationError().
+//! - The quality is limited to 8 bits (-127 to 127) and the age saturates at 255.
+//!
+//! GameTree uses TranspositionTable. To search with this table instead, name it as the TranspositionTable policy of a
+//! BasicGameTree (see GameTreePolicies.h).
+//!
+//! @note    The fingerprint is assumed to be random and uniformly distributed.
+
+class CompactTranspositionTable
+{
+public:
+    //! Constructor
+    CompactTranspositionTable(size_t indexSize, int maxAge, StaticEvaluator const & sef);
+
+    //! Constructor. The number of entries is the largest power of two that fits in the budget.
+    CompactTranspositionTable(MemoryBudget budget, int maxAge, StaticEvaluator const & sef);
+
+    //! Result type returned by check().
+    //! @param  _0  value of the state
+    //! @param  _1  quality of the returned value
+    using CheckResult = std::pair<float, int>;
+
+    //! Returns the stored value and quality of the given state
+    std::optional<CheckResult> check(uint64_t fingerprint) const;
+
+    //! Returns the stored value and quality of the given state
+    std::optional<CheckResult> check(uint64_t fingerprint, int minQ) const;
+
+    //! Stores a value in the table if the quality of its value is higher
+    void update(uint64_t fingerprint, float value, int quality);
+
+    //! Stores a value in the table regardless of the quality
+    void set(uint64_t fingerprint, float value, int quality);
+
+    //! Starts loading the entry for the given state into the cache so that a subsequent check() or update() does not stall.
+    void prefetch(uint64_t fingerprint) const { GamePlayer::prefetch(&find(fingerprint)); }
+
+    //! Bumps the ages of table entries so that they can eventually be replaced by newer entries.
+    void age();
+
+    //! Returns the largest difference between a stored value and the value returned by check()
+    float maxQuantizationError() const { return 0.5f / scale_; }
+
+    //! Changes the number of entries in the table
+    void resize(size_t size, bool keepEntries = true);
+
+    //! Changes the number of entries in the table to the largest power of two that fits in the budget
+    void resize(MemoryBudget budget, bool keepEntries = true) { resize(entriesInBudget(budget, sizeof(Entry)), keepEntries); }
+
+    //! Removes all entries from the table
+    void clear(unsigned threads = 0);
+
+    //! Returns an estimate of the fraction of the entries that are in use
+    float occupancy(size_t samples = 1024) const;
+
+    //! Returns the number of entries in the table
+    size_t size() const { return size_; }
+
+    //! Returns the amount of memory used by the entries
+    size_t bytes() const { return size_ * sizeof(Entry); }
+
+#if defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+    // Analysis data
+
+    struct AnalysisData
+    {
+        int checkCount;     // The number of accesses of entries in the table
+        int updateCount;    // The number of updates to entries in the table
+        int hitCount;       // The number of times an existing entry was found in the table
+        int collisionCount; // The number of times a different state was found in an entry
+        int rejected;       // The number of times an update was rejected
+        int overwritten;    // The number of times a state's entry was overwritten by a different state
+        int refreshed;      // The number of times a state's entry was updated with a newer value
+        int usage;          // The number of entries in use
+
+        AnalysisData();
+        void           reset();
+        nlohmann::json toJson() const;
+    };
+
+    mutable AnalysisData analysisData_;
+
+#endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
+
+private:
+    // See TranspositionTable for a note about age and quality.
+    struct Entry
+    {
+        uint32_t        key_;   // The upper 32 bits of the state's fingerprint
+        int16_t         value_; // The state's quantized value
+        int8_t          q_;     // The quality of the value
+        mutable uint8_t age_;   // The number of turns since the entry has been referenced
+
+        static int8_t constexpr UNUSED = INT8_MIN;
+        bool isUnused() const { return q_ == UNUSED; }
+        void clear() { q_ = UNUSED; }
+    };
+    // Check that the size of Entry is 8 bytes, which is the whole point of this class.
+    static_assert(sizeof(Entry) == 8, "Entry should be 8 bytes");
+
+    static int16_t constexpr ALICE_WINS_CODE = INT16_MAX;
+    static int16_t constexpr BOB_WINS_CODE   = -INT16_MAX;
+
+    // Marks all of the entries as unused
+    static void invalidate(Entry * table, size_t size, unsigned threads);
+
+    static uint32_t keyOf(uint64_t fingerprint) { return static_cast<uint32_t>(fingerprint >> 32); }
+
+    int16_t quantize(float value) const;
+    float   dequantize(int16_t code) const;
+
+    Entry const & find(uint64_t hash) const { return table_[hash % size_]; }
+    Entry &       find(uint64_t hash) { return table_[hash % size_]; }
+
+    std::unique_ptr<Entry[]> table_; // The entries. They are not initialized when allocated (see invalidate()).
+    size_t                   size_;  // Number of entries
+    int                      maxAge_;
+    float                    aliceWinsValue_;
+    float                    bobWinsValue_;
+    MateDistance             mateDistance_;
+    float                    midValue_; // Value that is quantized to 0
+    float                    scale_;    // Quantization steps per unit of value
+};
+
+} // namespace GamePlayer
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#elif !defined(__aarch64__)
+#include <chrono>
+#endif
+
+namespace GamePlayer
+{
+//! Returns the value of the processor's cycle counter.
+//!
+//! Reading the counter takes a few nanoseconds and does not serialize execution, so it is cheap enough to bracket small pieces of
+//! code. The counter only measures elapsed time: its rate is constant but platform-dependent (the TSC on x86, the virtual counter
+//! on ARM64), so a count is converted to time by comparing it to a clock over a longer interval. On other platforms, the counter
+//! is the steady clock in nanoseconds.
+inline uint64_t readCycleCounter()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    uint64_t count;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(count));
+    return count;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+} // namespace GamePlayer
@@ -14,6 +14,22 @@ namespace GamePlayer
 class GameState
 {
 public:
+    GameState() = default;
+
+    //! Copy constructor. The cached fingerprint is not copied because a copy is usually modified to create a response.
+    GameState(GameState const & src)
+        : response_(src.response_)
+    {
+    }
+
+    //! Assignment operator. The cached fingerprint is invalidated.
+    GameState & operator=(GameState const & rhs)
+    {
+        response_         = rhs.response_;
+        fingerprintValid_ = false;
+        return *this;
+    }
+
     virtual ~GameState() = default;
 
     //! IDs of the players.
@@ -29,6 +45,34 @@ public:
     //! @note   This function must be overridden.
     virtual uint64_t fingerprint() const = 0;
 
+    //! Returns the fingerprint of this state, calling fingerprint() only if it is not already known.
+    //!
+    //! The search uses this function instead of fingerprint() because it needs the fingerprint several times per state.
+    //!
+    //! @note   This function is not thread-safe the first time it is called.
+    uint64_t cachedFingerprint() const
+    {
+        if (!fingerprintValid_)
+        {
+            fingerprint_      = fingerprint();
+            fingerprintValid_ = true;
+        }
+        return fingerprint_;
+    }
+
+    //! Sets the cached fingerprint of this state.
+    //!
+    //! This allows a response generator to update the fingerprint incrementally (see ZobristHash) instead of computing it from
+    //! scratch. The value must be the same as the value fingerprint() would return.
+    void setCachedFingerprint(uint64_t fingerprint)
+    {
+        fingerprint_      = fingerprint;
+        fingerprintValid_ = true;
+    }
+
+    //! Invalidates the cached fingerprint. This must be called if the state is modified after the fingerprint is cached.
+    void invalidateCachedFingerprint() { fingerprintValid_ = false; }
+
     //! Returns the ID of the player that will respond to this state
     //!
     //! @return The ID of the player that responds to this state
@@ -48,5 +92,9 @@ public:
         nlohmann::json toJson() const;
     };
 #endif // defined(ANALYSIS_GAME_STATE)
+
+private:
+    mutable uint64_t fingerprint_      = 0;     // Cached fingerprint
+    mutable bool     fingerprintValid_ = false; // True if fingerprint_ is valid
 };
 } // namespace GamePlayer
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace GamePlayer
+{
+template <typename Policies>
+class BasicGameTree;
+
+struct DefaultGameTreePolicies;
+
+//! The game tree configured by the build options. See GameTree.h.
+using GameTree = BasicGameTree<DefaultGameTreePolicies>;
+} // namespace GamePlayer
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <nlohmann/json.hpp>
+#include <vector>
+#if defined(ANALYSIS_GAME_STATE)
+#include "GamePlayer/GameState.h"
+#endif // defined(ANALYSIS_GAME_STATE)
+
+namespace GamePlayer
+{
+
+//! @file
+//! Policies that configure a BasicGameTree at compile time.
+//!
+//! A policy set is a struct that names the types used by the search and the features that are enabled. The features are usually
+//! inherited from GameTreeFeatures and overridden as needed:
+//!
+//!     struct MyPolicies : GamePlayer::GameTreeFeatures
+//!     {
+//!         using TranspositionTable = GamePlayer::CompactTranspositionTable; // check(), update(), prefetch()
+//!         using Evaluator          = MyEvaluator;                          // Derived from StaticEvaluator
+//!         using MoveOrdering       = GamePlayer::ValueOrdering;            // Order in which responses are searched
+//!         using Statistics         = GamePlayer::NullStatistics;           // Receives the search's statistics
+//!         static bool constexpr NULL_MOVE_PRUNING = false;                 // Overrides GameTreeFeatures
+//!     };
+//!
+//! Since the types are known at compile time, calls to them are resolved statically (an evaluator that is declared final is not
+//! called virtually), and a feature that is disabled compiles to nothing.
+
+//! The features of the search that can be removed at compile time. A feature that is enabled here must still be enabled at run
+//! time (for example, by BasicGameTree::setNullMovePruning()), so enabling a feature that is not used costs only a test. A feature
+//! that is disabled here has no code and no data in the tree, and calling its setter does not compile.
+struct GameTreeFeatures
+{
+    static bool constexpr TRANSPOSITION_TABLE_LOOKUPS = true;  // Values are cached in the T-table (if false, it may be null)
+    static bool constexpr POSITION_DATABASE           = true;  // A position database is consulted
+    static bool constexpr LATE_MOVE_REDUCTIONS        = true;  // Late responses are searched to a reduced depth
+    static bool constexpr NULL_MOVE_PRUNING           = true;  // States are pruned if passing causes a cutoff
+    static bool constexpr REPETITION_DETECTION        = true;  // Repeated states are scored as draws
+    static bool constexpr SEARCH_TRACE                = true;  // The search can be recorded in a SearchTrace
+    static bool constexpr PHASE_TIMING                = true;  // The phases of the search can be timed
+    static bool constexpr QUIESCENT_SEARCH            = false; // Unstable values are searched one more ply
+};
+
+//! Move ordering that searches the best responses first, by their preliminary values.
+//!
+//! The earlier the best response is searched, the more of the remaining responses are pruned.
+struct ValueOrdering
+{
+    //! Sorts the responses so that the best response for the player to move is first
+    template <typename Node>
+    static void sort(std::vector<Node> & responses, bool aliceToMove)
+    {
+        if (aliceToMove)
+            std::sort(responses.begin(), responses.end(), [](Node const & a, Node const & b) { return a.value > b.value; });
+        else
+            std::sort(responses.begin(), responses.end(), [](Node const & a, Node const & b) { return a.value < b.value; });
+    }
+};
+
+//! Move ordering that searches the responses in the order they are generated.
+//!
+//! This is useful if the response generator already orders its responses, or if the preliminary values are of no use for ordering.
+struct NoOrdering
+{
+    template <typename Node>
+    static void sort(std::vector<Node> &, bool)
+    {
+    }
+};
+
+//! A statistics sink that discards everything. All of its functions compile to nothing.
+struct NullStatistics
+{
+    void onGenerated(int, size_t) {}
+    void onEvaluated(int) {}
+    void onAlphaCutoff() {}
+    void onBetaCutoff() {}
+    void onDatabaseHit() {}
+    void onLateMoveReduction() {}
+    void onLateMoveResearch() {}
+    void onNullMoveCutoff() {}
+    void onMateDistanceCutoff() {}
+    void onRepetition() {}
+    void onSearchDone(float) {}
+};
+
+//! A statistics sink that collects the data relevant to the game tree's operation.
+//!
+//! @note   The layout depends on ANALYSIS_GAME_STATE, which adds the GameState analysis data.
+struct GameTreeAnalysisData
+{
+    static size_t constexpr MAX_DEPTH = 10; // Maximum number of plies tracked
+    int   generatedCounts[MAX_DEPTH];
+    int   evaluatedCounts[MAX_DEPTH];
+    float value;
+    int   alphaCutoffs;
+    int   betaCutoffs;
+    int   databaseHits;
+    int   lateMoveReductions;  // Number of responses searched to a reduced depth
+    int   lateMoveResearches;  // Number of reduced responses searched again at full depth
+    int   nullMoveCutoffs;     // Number of states pruned by null-move pruning
+    int   mateDistanceCutoffs; // Number of states pruned by mate-distance pruning
+    int   repetitions;         // Number of responses scored as a draw because they repeat a state on the path
+#if defined(ANALYSIS_GAME_STATE)
+    GameState::AnalysisData gsAnalysisData;
+#endif // defined(ANALYSIS_GAME_STATE)
+
+    GameTreeAnalysisData();
+    void           reset();
+    float          effectiveBranchingFactor() const;
+    nlohmann::json toJson() const;
+
+    void onGenerated(int depth, size_t count)
+    {
+        if (depth < (int)MAX_DEPTH)
+            generatedCounts[depth] += (int)count;
+    }
+    void onEvaluated(int depth)
+    {
+        if (depth < (int)MAX_DEPTH)
+            ++evaluatedCounts[depth];
+    }
+    void onAlphaCutoff() { ++alphaCutoffs; }
+    void onBetaCutoff() { ++betaCutoffs; }
+    void onDatabaseHit() { ++databaseHits; }
+    void onLateMoveReduction() { ++lateMoveReductions; }
+    void onLateMoveResearch() { ++lateMoveResearches; }
+    void onNullMoveCutoff() { ++nullMoveCutoffs; }
+    void onMateDistanceCutoff() { ++mateDistanceCutoffs; }
+    void onRepetition() { ++repetitions; }
+    void onSearchDone(float v) { value = v; }
+};
+
+inline GameTreeAnalysisData::GameTreeAnalysisData()
+    : value(0)
+    , alphaCutoffs(0)
+    , betaCutoffs(0)
+    , databaseHits(0)
+    , lateMoveReductions(0)
+    , lateMoveResearches(0)
+    , nullMoveCutoffs(0)
+    , mateDistanceCutoffs(0)
+    , repetitions(0)
+{
+    memset(generatedCounts, 0, sizeof(generatedCounts));
+    memset(evaluatedCounts, 0, sizeof(evaluatedCounts));
+}
+
+inline void GameTreeAnalysisData::reset()
+{
+    memset(generatedCounts, 0, sizeof(generatedCounts));
+    memset(evaluatedCounts, 0, sizeof(evaluatedCounts));
+
+    value        = 0.0f;
+    alphaCutoffs = 0;
+    betaCutoffs  = 0;
+    databaseHits = 0;
+
+    lateMoveReductions = 0;
+    lateMoveResearches = 0;
+    nullMoveCutoffs    = 0;
+
+    mateDistanceCutoffs = 0;
+    repetitions         = 0;
+
+#if defined(ANALYSIS_GAME_STATE)
+    gsAnalysisData.reset();
+#endif // defined(ANALYSIS_GAME_STATE)
+}
+
+// The effective branching factor is the branching factor of a uniform tree with the same depth and the same number of nodes. It
+// measures how well the tree is pruned.
+inline float GameTreeAnalysisData::effectiveBranchingFactor() const
+{
+    // Note: generatedCounts[d] is the number of states at ply d + 1
+    int    depth = 0;
+    double nodes = 0.0;
+    for (size_t d = 0; d < MAX_DEPTH; ++d)
+    {
+        nodes += generatedCounts[d];
+        if (generatedCounts[d] > 0)
+            depth = (int)d + 1;
+    }
+    if (depth == 0)
+        return 0.0f;
+    return (float)std::pow(nodes, 1.0 / depth);
+}
+
+inline nlohmann::json GameTreeAnalysisData::toJson() const
+{
+    nlohmann::json out = {{"generatedCounts", generatedCounts},
+                          {"evaluatedCounts", evaluatedCounts},
+                          {"value", value},
+                          {"alphaCutoffs", alphaCutoffs},
+                          {"betaCutoffs", betaCutoffs},
+                          {"databaseHits", databaseHits},
+                          {"lateMoveReductions", lateMoveReductions},
+                          {"lateMoveResearches", lateMoveResearches},
+                          {"nullMoveCutoffs", nullMoveCutoffs},
+                          {"mateDistanceCutoffs", mateDistanceCutoffs},
+                          {"repetitions", repetitions},
+                          {"effectiveBranchingFactor", effectiveBranchingFactor()}
+
+#if defined(ANALYSIS_GAME_STATE)
+                          ,
+                          {"gameState", gsAnalysisData.toJson()}
+#endif // defined(ANALYSIS_GAME_STATE)
+    };
+    return out;
+}
+
+} // namespace GamePlayer
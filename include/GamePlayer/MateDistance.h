@@ -0,0 +1,103 @@
+#pragma once
+
+#include "GamePlayer/StaticEvaluator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace GamePlayer
+{
+
+//! Win/loss values adjusted by the distance to the win/loss.
+//!
+//! The static evaluator returns a single value for every win. In order to prefer faster wins (and slower losses), the search
+//! reduces the magnitude of a win by a small step for each ply between the root of the search and the winning state, so a win in
+//! n plies has the value aliceWinsIn(n). The values of all wins lie in a narrow band at each end of the range of values, and any
+//! value in that band is a win.
+//!
+//! A value in the search is relative to the root of the search, but a value stored in a transposition table must not depend on
+//! where the search started, so it is stored relative to the state itself. toTable() and toSearch() convert between the two.
+//!
+//! @note   The non-winning values returned by the static evaluator must lie outside of the bands. Each band is
+//!         MAX_DISTANCE * step() (1/256 of the range between bobWinsValue() and aliceWinsValue()) wide.
+//! @note   The range must be finite, so neither win value may be infinite or +/-std::numeric_limits<float>::max().
+
+class MateDistance
+{
+public:
+    //! Maximum distance to a win/loss that can be represented, in plies
+    static int constexpr MAX_DISTANCE = 256;
+
+    //! Constructor
+    explicit MateDistance(StaticEvaluator const & sef)
+        : aliceWinsValue_(sef.aliceWinsValue())
+        , bobWinsValue_(sef.bobWinsValue())
+        , step_((aliceWinsValue_ - bobWinsValue_) / 65536.0f)
+        , aliceWinsThreshold_(aliceWinsValue_ - MAX_DISTANCE * step_)
+        , bobWinsThreshold_(bobWinsValue_ + MAX_DISTANCE * step_)
+    {
+        // The steps are a fraction of the range, so the range must be finite and not empty
+        assert(std::isfinite(step_) && step_ > 0.0f);
+    }
+
+    //! Returns the change in the value of a win/loss per ply
+    float step() const { return step_; }
+
+    //! Returns true if the value is a win for Alice
+    bool isAliceWin(float value) const { return value >= aliceWinsThreshold_; }
+
+    //! Returns true if the value is a win for Bob
+    bool isBobWin(float value) const { return value <= bobWinsThreshold_; }
+
+    //! Returns the value of a win for Alice in the given number of plies
+    float aliceWinsIn(int plies) const { return aliceWinsValue_ - (float)std::min(plies, MAX_DISTANCE) * step_; }
+
+    //! Returns the value of a win for Bob in the given number of plies
+    float bobWinsIn(int plies) const { return bobWinsValue_ + (float)std::min(plies, MAX_DISTANCE) * step_; }
+
+    //! Returns the number of plies to the win/loss, or -1 if the value is not a win/loss
+    int distance(float value) const
+    {
+        if (isAliceWin(value))
+            return (int)std::lround((aliceWinsValue_ - std::min(value, aliceWinsValue_)) / step_);
+        if (isBobWin(value))
+            return (int)std::lround((std::max(value, bobWinsValue_) - bobWinsValue_) / step_);
+        return -1;
+    }
+
+    //! Converts a value relative to a state to a value relative to the root of the search.
+    //!
+    //! @param  value   Value of the state, as returned by the static evaluator or stored in a transposition table
+    //! @param  ply     Distance of the state from the root
+    float toSearch(float value, int ply) const
+    {
+        if (isAliceWin(value))
+            return aliceWinsIn(distance(value) + ply);
+        if (isBobWin(value))
+            return bobWinsIn(distance(value) + ply);
+        return value;
+    }
+
+    //! Converts a value relative to the root of the search to a value relative to a state.
+    //!
+    //! @param  value   Value of the state in the search
+    //! @param  ply     Distance of the state from the root
+    float toTable(float value, int ply) const
+    {
+        if (isAliceWin(value))
+            return aliceWinsIn(std::max(distance(value) - ply, 0));
+        if (isBobWin(value))
+            return bobWinsIn(std::max(distance(value) - ply, 0));
+        return value;
+    }
+
+private:
+    float aliceWinsValue_;
+    float bobWinsValue_;
+    float step_;               // Change in value per ply
+    float aliceWinsThreshold_; // Any value at or above this is a win for Alice
+    float bobWinsThreshold_;   // Any value at or below this is a win for Bob
+};
+
+} // namespace GamePlayer
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "GamePlayer/GameTree.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#if defined(ANALYSIS_GAME_TREE)
+#include <nlohmann/json_fwd.hpp>
+#endif // defined(ANALYSIS_GAME_TREE)
+
+namespace GamePlayer
+{
+class GameState;
+class StaticEvaluator;
+
+//! A game tree search implementation using Monte Carlo tree search.
+//!
+//! This is an alternative to GameTree for games whose branching factor is too large for a full-width search to reach a useful
+//! depth. Instead of searching every response to a fixed depth, the tree is grown one state at a time toward the most promising
+//! responses, until the time budget runs out. The response that was explored the most is chosen.
+//!
+//! The same GameState, ResponseGenerator and StaticEvaluator used by GameTree are used here:
+//!
+//! - Responses are selected with UCT, or with PUCT, in which case the static evaluations of the responses are used as priors.
+//! - A newly added state is valued by its static evaluation ("value cutoff"), or by a short rollout guided by the static
+//!   evaluator, followed by a static evaluation.
+//! - The search runs on multiple threads sharing one tree. Virtual loss steers the threads toward different parts of the tree.
+//!
+//! Values in the tree are normalized to the range [0, 1], where 0 is a win for Bob and 1 is a win for Alice.
+//!
+//! @note   If more than one thread is used, the response generator and the static evaluator must be thread-safe.
+
+class MonteCarloTreeSearch
+{
+public:
+    //! Response generator function object type. See GameTree::ResponseGenerator.
+    using ResponseGenerator = GameTree::ResponseGenerator;
+
+    //! Selection strategy
+    enum class Selection
+    {
+        UCT, //!< Upper confidence bound applied to trees
+        PUCT //!< UCT with priors computed by the static evaluator
+    };
+
+    //! Search options
+    struct Options
+    {
+        Selection selection        = Selection::PUCT; //!< Selection strategy
+        float     exploration      = 1.4f;            //!< Exploration constant (c in UCT/PUCT)
+        float     priorTemperature = 0.1f;            //!< PUCT: softmax temperature of the priors, in normalized value units
+        int       rolloutDepth     = 0;               //!< Number of plies in a rollout, or 0 to use the static evaluation
+        float     rolloutEpsilon   = 0.1f;            //!< Probability of a random move (instead of the best) in a rollout
+        int       threads          = 1;               //!< Number of search threads
+        int       virtualLoss      = 1;               //!< Number of losses added to a state while a thread is searching it
+        size_t    maxNodes         = 1 << 20;         //!< Maximum number of states in the tree (see findBestResponse())
+        long      maxIterations    = 0;               //!< Maximum number of descents of the tree, or 0 for no limit
+        uint64_t  seed             = 0;               //!< Random number seed for rollouts
+    };
+
+    //! Constructor.
+    //!
+    //! @param 	sef         The static evaluation function
+    //! @param  rg          The response generator
+    //! @param  options     Search options
+    MonteCarloTreeSearch(std::shared_ptr<StaticEvaluator> sef, ResponseGenerator rg, Options const & options);
+
+    //! Constructor using the default options.
+    MonteCarloTreeSearch(std::shared_ptr<StaticEvaluator> sef, ResponseGenerator rg);
+
+    //! Searches for the best response to the given state.
+    //!
+    //! The search ends when the time budget is spent, the tree is full, or the iteration limit is reached. The responses to s0
+    //! are always added to the tree, even if there are more of them than Options::maxNodes, so a response is chosen unless the
+    //! game is over.
+    //!
+    //! @param  s0      The current state
+    //! @param  budget  Maximum amount of time to search
+    //!
+    //! @return     The value of s0, in the range of the static evaluator's values. The chosen response is returned in
+    //!             s0->response_.
+    float findBestResponse(std::shared_ptr<GameState> & s0, std::chrono::milliseconds budget) const;
+
+#if defined(ANALYSIS_GAME_TREE)
+
+    //! Analysis data relevant to the search
+    struct AnalysisData
+    {
+        long   iterations; // Number of times the tree was descended
+        size_t nodes;      // Number of states in the tree
+        int    maxDepth;   // Depth of the deepest state in the tree
+        int    rootVisits; // Number of visits of the root
+        float  value;      // Value of the root
+
+        AnalysisData();
+        void           reset();
+        nlohmann::json toJson() const;
+    };
+
+    //! Analysis data for the last move
+    mutable AnalysisData analysisData_;
+
+#endif // defined(ANALYSIS_GAME_TREE)
+
+private:
+    struct Node;
+    class NodePool;
+    class Search;
+
+    std::shared_ptr<StaticEvaluator> staticEvaluator_;
+    ResponseGenerator                responseGenerator_;
+    Options                          options_;
+};
+} // namespace GamePlayer
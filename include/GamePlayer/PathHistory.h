@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GamePlayer
+{
+
+//! The fingerprints of the states on the path from the start of the game to the state being searched.
+//!
+//! The fingerprints are kept in a stack, in order, and in a small open-addressed hash set so that a repeated state is detected in
+//! O(1). Since the stack and the set change in LIFO order, removing the last fingerprint only requires clearing the slot it was put
+//! in: any fingerprint that was added after it has already been removed, so the set is exactly as it was before the fingerprint was
+//! added.
+//!
+//! @note   The fingerprint (uint64_t)-1 is reserved.
+
+class PathHistory
+{
+public:
+    //! Constructor
+    //!
+    //! @param  capacity    Number of fingerprints expected to be on the path. The set grows if necessary.
+    explicit PathHistory(size_t capacity = 64)
+    {
+        size_t size = 1;
+        while (size < capacity * 2)
+            size <<= 1;
+        slots_.assign(size, UNUSED);
+        mask_ = size - 1;
+    }
+
+    //! Returns true if the fingerprint is on the path
+    bool contains(uint64_t fingerprint) const
+    {
+        for (size_t i = fingerprint & mask_; slots_[i] != UNUSED; i = (i + 1) & mask_)
+        {
+            if (slots_[i] == fingerprint)
+                return true;
+        }
+        return false;
+    }
+
+    //! Adds a fingerprint to the end of the path
+    void push(uint64_t fingerprint)
+    {
+        // Keep the load factor at most 1/2 so that probe sequences remain short
+        if ((stack_.size() + 1) * 2 > slots_.size())
+            grow();
+        stack_.push_back(Entry{fingerprint, insert(fingerprint)});
+    }
+
+    //! Removes the fingerprint at the end of the path
+    void pop()
+    {
+        slots_[stack_.back().slot] = UNUSED;
+        stack_.pop_back();
+    }
+
+    //! Removes all fingerprints
+    void clear()
+    {
+        for (Entry const & entry : stack_)
+        {
+            slots_[entry.slot] = UNUSED;
+        }
+        stack_.clear();
+    }
+
+    //! Returns the number of fingerprints on the path
+    size_t size() const { return stack_.size(); }
+
+private:
+    static uint64_t constexpr UNUSED = (uint64_t)-1;
+
+    struct Entry
+    {
+        uint64_t fingerprint;
+        size_t   slot; // Slot in the set occupied by the fingerprint
+    };
+
+    // Puts the fingerprint in the first free slot of its probe sequence and returns the slot
+    size_t insert(uint64_t fingerprint)
+    {
+        size_t i = fingerprint & mask_;
+        while (slots_[i] != UNUSED)
+        {
+            i = (i + 1) & mask_;
+        }
+        slots_[i] = fingerprint;
+        return i;
+    }
+
+    // Doubles the size of the set. The fingerprints are inserted again in order, so the LIFO property is preserved.
+    void grow()
+    {
+        slots_.assign(slots_.size() * 2, UNUSED);
+        mask_ = slots_.size() - 1;
+        for (Entry & entry : stack_)
+        {
+            entry.slot = insert(entry.fingerprint);
+        }
+    }
+
+    std::vector<uint64_t> slots_; // Open-addressed set of the fingerprints
+    size_t                mask_;  // Number of slots - 1
+    std::vector<Entry>    stack_; // The fingerprints in path order
+};
+
+} // namespace GamePlayer
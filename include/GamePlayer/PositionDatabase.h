@@ -0,0 +1,134 @@
+#pragma once
+
+#include "GamePlayer/GameState.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace GamePlayer
+{
+
+//! A read-only database of precomputed state values and best responses, referenced by the states' fingerprints.
+//!
+//! The database is used as an opening book or an endgame table. GameTree consults it before searching a state, and if the state
+//! is found, the stored value and response are used instead of searching.
+//!
+//! The database file is memory-mapped, so opening it is cheap and only the pages that are referenced are loaded. The file is a
+//! header followed by records sorted by fingerprint. Since fingerprints are uniformly distributed, records are found with an
+//! interpolation search that typically takes only a few probes.
+//!
+//! @note   The file is written in the native byte order and is not portable between platforms with different byte orders.
+
+class PositionDatabase
+{
+public:
+    //! A precomputed result.
+    struct Record
+    {
+        uint64_t fingerprint; //!< Fingerprint of the state
+        uint64_t response;    //!< Fingerprint of the best response, or 0 if there is none
+        float    value;       //!< Value of the state
+        int32_t  quality;     //!< Quality of the value (the number of plies searched to compute it)
+    };
+    static_assert(sizeof(Record) == 24, "Record should be 24 bytes");
+
+    ~PositionDatabase();
+
+    PositionDatabase(PositionDatabase const &)             = delete;
+    PositionDatabase & operator=(PositionDatabase const &) = delete;
+
+    //! Opens a database file.
+    //!
+    //! @param  path    Path of the file
+    //!
+    //! @return The database, or nullptr if the file could not be opened or is not a valid database
+    static std::shared_ptr<PositionDatabase> open(std::string const & path);
+
+    //! Writes a database file.
+    //!
+    //! @param  path    Path of the file
+    //! @param  records Records to be written. They do not need to be sorted. If there are records with the same fingerprint,
+    //!                 the one with the highest quality is kept.
+    //!
+    //! @return true if the file was written successfully
+    static bool write(std::string const & path, std::vector<Record> records);
+
+    //! Returns the record of the given state, if it is in the database.
+    std::optional<Record> find(uint64_t fingerprint) const;
+
+    //! Returns the number of records in the database
+    size_t size() const { return count_; }
+
+private:
+    PositionDatabase() = default;
+
+    void unmap();
+
+    void const *   mapping_     = nullptr; // Start of the mapped file
+    size_t         mappingSize_ = 0;       // Size of the mapped file
+    Record const * records_     = nullptr; // Records, sorted by fingerprint
+    size_t         count_       = 0;       // Number of records
+#if defined(_WIN32)
+    void * file_          = nullptr; // File handle
+    void * mappingHandle_ = nullptr; // File mapping handle
+#endif // defined(_WIN32)
+};
+
+//! Builds a PositionDatabase by searching states with a game tree (a GameTree or any other BasicGameTree).
+//!
+//! This is intended to be used offline by a program that enumerates the states to be stored (for example, all states within a
+//! few plies of the start of the game, or all states with only a few pieces). The search should be much deeper than the search
+//! used in play so that the stored values are worth more than a search.
+//!
+//! Example:
+//!
+//!     GameTree                tree(tt, sef, rg, 12);
+//!     PositionDatabaseBuilder builder(tree);
+//!     for (auto & state : statesToStore)
+//!         builder.add(state);
+//!     builder.write("book.gpdb");
+
+template <typename Tree>
+class PositionDatabaseBuilder
+{
+public:
+    //! Constructor
+    //!
+    //! @param  tree    The game tree used to search the states. Its search depth is recorded as the quality of the values.
+    explicit PositionDatabaseBuilder(Tree const & tree)
+        : tree_(tree)
+    {
+    }
+
+    //! Searches the given state and adds the result to the database.
+    //!
+    //! @param  state   State to add. On return, state->response_ is the best response.
+    void add(std::shared_ptr<GameState> & state)
+    {
+        float                      value    = tree_.findBestResponse(state);
+        std::shared_ptr<GameState> response = state->response_;
+        records_.push_back(PositionDatabase::Record{
+            state->cachedFingerprint(), response ? response->cachedFingerprint() : 0, value, tree_.maxDepth()});
+    }
+
+    //! Adds a precomputed result to the database
+    void add(PositionDatabase::Record const & record) { records_.push_back(record); }
+
+    //! Writes the database file
+    //!
+    //! @return true if the file was written successfully
+    bool write(std::string const & path) const { return PositionDatabase::write(path, records_); }
+
+    //! Returns the number of records added so far
+    size_t size() const { return records_.size(); }
+
+private:
+    Tree const &                          tree_;
+    std::vector<PositionDatabase::Record> records_;
+};
+
+} // namespace GamePlayer
@@ -0,0 +1,23 @@
+#pragma once
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace GamePlayer
+{
+//! Hints to the processor that the cache line containing the given address will be read soon.
+//!
+//! The load is started without waiting for it to complete, so the latency of several loads can be overlapped by prefetching them
+//! all before using any of them. On platforms without a prefetch instruction, this does nothing.
+inline void prefetch(void const * address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<char const *>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+} // namespace GamePlayer
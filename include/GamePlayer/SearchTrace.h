@@ -0,0 +1,131 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GamePlayer
+{
+
+//! A recording of the states visited by a search, for offline profiling.
+//!
+//! When a trace is attached to a GameTree (see GameTree::setSearchTrace()), an event is recorded when the search of a state begins
+//! and another when it ends. Every response that is generated is also recorded as a leaf (see LEAF) while its preliminary value is
+//! computed, so the states at the horizon, values found in the transposition table, and repetitions are included. The events are
+//! fixed-size binary records, so recording one is little more than a copy and a clock read, and a trace can be left enabled in
+//! production.
+//!
+//! Events are recorded either into a ring buffer in memory, which keeps the most recent events and can be saved when a move takes
+//! too long, or streamed to a file. Trace files are read with read(), and the trace-replay tool summarizes them.
+//!
+//! @note   The file is written in the native byte order and is not portable between platforms with different byte orders.
+
+class SearchTrace
+{
+public:
+    //! Event flags
+    enum Flags : uint8_t
+    {
+        EXIT             = 0x01, //!< The search of the state ended (otherwise, it began)
+        ALPHA_CUTOFF     = 0x02, //!< The search was cut off because the value is lower than alpha
+        BETA_CUTOFF      = 0x04, //!< The search was cut off because the value is higher than beta
+        DATABASE_HIT     = 0x08, //!< The value was found in the position database
+        NULL_MOVE_CUTOFF = 0x10, //!< The state was pruned by null-move pruning
+        NO_RESPONSES     = 0x20, //!< The state has no responses
+        LEAF             = 0x40, //!< The state's preliminary value was computed without a search (set on both events)
+        TT_HIT           = 0x80  //!< The value of a LEAF was found in the transposition table
+    };
+
+    //! A recorded event
+    struct Event
+    {
+        uint64_t time;        //!< Nanoseconds since the trace was created
+        uint64_t fingerprint; //!< Fingerprint of the state
+        float    alpha;       //!< Alpha at the time of the event
+        float    beta;        //!< Beta at the time of the event
+        float    value;       //!< Value of the state (only valid for EXIT events)
+        int16_t  quality;     //!< Quality of the value (only valid for EXIT events)
+        uint8_t  depth;       //!< Ply of the state
+        uint8_t  flags;       //!< Flags
+    };
+    static_assert(sizeof(Event) == 32, "Event should be 32 bytes");
+
+    ~SearchTrace();
+
+    SearchTrace(SearchTrace const &)             = delete;
+    SearchTrace & operator=(SearchTrace const &) = delete;
+
+    //! Creates a trace that keeps the most recent events in memory.
+    //!
+    //! @param  capacity    Number of events kept. It is rounded up to a power of two.
+    static std::shared_ptr<SearchTrace> createRingBuffer(size_t capacity);
+
+    //! Creates a trace that streams the events to a file.
+    //!
+    //! @param  path    Path of the file
+    //!
+    //! @return The trace, or nullptr if the file could not be created
+    static std::shared_ptr<SearchTrace> createFile(std::string const & path);
+
+    //! Records the beginning of the search of a state
+    void enter(uint64_t fingerprint, int depth, float alpha, float beta, uint8_t flags = 0)
+    {
+        record(Event{now(), fingerprint, alpha, beta, 0.0f, 0, (uint8_t)depth, (uint8_t)(flags & ~EXIT)});
+    }
+
+    //! Records the end of the search of a state
+    void exit(uint64_t fingerprint, int depth, float alpha, float beta, float value, int quality, uint8_t flags)
+    {
+        record(Event{now(), fingerprint, alpha, beta, value, (int16_t)quality, (uint8_t)depth, (uint8_t)(flags | EXIT)});
+    }
+
+    //! Returns the events in memory, in order. For a file trace, these are the events that have not been written yet.
+    std::vector<Event> events() const;
+
+    //! Writes any buffered events to the file. For a ring buffer, this does nothing.
+    //!
+    //! @return true if every event recorded so far has been written successfully
+    bool flush();
+
+    //! Writes the events in memory to a trace file.
+    //!
+    //! @return true if the file was written successfully
+    bool save(std::string const & path) const;
+
+    //! Reads a trace file.
+    //!
+    //! @param  path    Path of the file
+    //! @param  events  The events in the file, in order
+    //!
+    //! @return true if the file was read successfully
+    static bool read(std::string const & path, std::vector<Event> * events);
+
+private:
+    SearchTrace(size_t capacity, FILE * file);
+
+    uint64_t now() const
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    void record(Event const & event)
+    {
+        buffer_[next_ & mask_] = event;
+        ++next_;
+        if (file_ && (next_ & mask_) == 0)
+            flush();
+    }
+
+    std::vector<Event>                    buffer_;
+    size_t                                mask_;           // Capacity - 1
+    size_t                                next_   = 0;     // Total number of events recorded since the last flush
+    FILE *                                file_;           // File being written, or nullptr for a ring buffer
+    bool                                  failed_ = false; // True if a write to the file has failed
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace GamePlayer
@@ -19,6 +19,10 @@ public:
     //! bobWinsValue() and aliceWinsValue(), unless the state is a win/loss. Returning aliceWinsValue() or bobWinsValue() indicates
     //! that the state is a win/loss.
     //!
+    //! Since the search adjusts win/loss values by their distance (see MateDistance), the band of MateDistance::MAX_DISTANCE *
+    //! MateDistance::step() (1/256 of the range) at each end of the range is reserved for wins/losses. A non-winning value must
+    //! not fall within either band, or it will be treated as a win/loss.
+    //!
     //! @param  state   State to be evaluated
     //!
     //! @return The value of the state
@@ -30,7 +34,7 @@ public:
     //!
     //! Any value greater than or equal to this value indicates a win for Alice. The returned value must be invariant. It must be
     //! higher than any non-winning value returned by evaluate() for Alice, but it must be less than
-    //! std::numeric_limits<float>::max().
+    //! std::numeric_limits<float>::max(), and aliceWinsValue() - bobWinsValue() must be finite.
     //!
     //! @return The value of a state in which Alice has won
     //!
@@ -40,7 +44,7 @@ public:
     //! Returns the value of a winning state for Bob.
     //!
     //! Any value less than or equal to this value indicates a win for Bob. The returned value must be invariant. It must be lower
-    //! than any non-winning value returned by evaluate() for Bob, but it must be greater than std::numeric_limits<float>::max().
+    //! than any non-winning value returned by evaluate() for Bob, but it must be greater than -std::numeric_limits<float>::max().
     //!
     //! @return The value of a state in which Bob has won
     //!
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+namespace GamePlayer
+{
+//! The size of a table given as the amount of memory it may use.
+struct MemoryBudget
+{
+    size_t bytes;
+};
+
+//! Returns the number of entries of a table that fit in the budget.
+//!
+//! The number is rounded down to a power of two so that the budget is never exceeded, but a table always has at least one entry.
+inline size_t entriesInBudget(MemoryBudget budget, size_t entrySize)
+{
+    size_t entries = 1;
+    while (entries * 2 <= budget.bytes / entrySize)
+        entries *= 2;
+    return entries;
+}
+} // namespace GamePlayer
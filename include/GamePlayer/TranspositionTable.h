@@ -4,8 +4,12 @@
 #include <nlohmann/json_fwd.hpp>
 #endif // defined(ANALYSIS_TRANSPOSITION_TABLE)
 
+#include "GamePlayer/Prefetch.h"
+#include "GamePlayer/TableSizing.h"
+
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -32,6 +36,9 @@ public:
     //! Constructor
     TranspositionTable(size_t indexSize, int maxAge);
 
+    //! Constructor. The number of entries is the largest power of two that fits in the budget.
+    TranspositionTable(MemoryBudget budget, int maxAge);
+
     //! Result type returned by check().
     //! @param  _0  value of the state
     //! @param  _1  quality of the returned value
@@ -49,9 +56,30 @@ public:
     //! Stores a value in the table regardless of the quality
     void set(uint64_t fingerprint, float value, int quality);
 
+    //! Starts loading the entry for the given state into the cache so that a subsequent check() or update() does not stall.
+    void prefetch(uint64_t fingerprint) const { GamePlayer::prefetch(&find(fingerprint)); }
+
     //! Bumps the ages of table entries so that they can eventually be replaced by newer entries.
     void age();
 
+    //! Changes the number of entries in the table
+    void resize(size_t size, bool keepEntries = true);
+
+    //! Changes the number of entries in the table to the largest power of two that fits in the budget
+    void resize(MemoryBudget budget, bool keepEntries = true) { resize(entriesInBudget(budget, sizeof(Entry)), keepEntries); }
+
+    //! Removes all entries from the table
+    void clear(unsigned threads = 0);
+
+    //! Returns an estimate of the fraction of the entries that are in use
+    float occupancy(size_t samples = 1024) const;
+
+    //! Returns the number of entries in the table
+    size_t size() const { return size_; }
+
+    //! Returns the amount of memory used by the entries
+    size_t bytes() const { return size_ * sizeof(Entry); }
+
 #if defined(ANALYSIS_TRANSPOSITION_TABLE)
 
     // Analysis data
@@ -95,11 +123,15 @@ private:
     static_assert(sizeof(float) == 4, "float is not 32 bits");
     static_assert(sizeof(Entry) == 16, "Entry should be 16 bytes");
 
-    Entry const & find(uint64_t hash) const { return table_[hash % table_.size()]; }
-    Entry &       find(uint64_t hash) { return table_[hash % table_.size()]; }
+    // Marks all of the entries as unused
+    static void invalidate(Entry * table, size_t size, unsigned threads);
+
+    Entry const & find(uint64_t hash) const { return table_[hash % size_]; }
+    Entry &       find(uint64_t hash) { return table_[hash % size_]; }
 
-    std::vector<Entry> table_;
-    int                maxAge_;
+    std::unique_ptr<Entry[]> table_; // The entries. They are not initialized when allocated (see invalidate()).
+    size_t                   size_;  // Number of entries
+    int                      maxAge_;
 };
 
 } // namespace GamePlayer
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace GamePlayer
+{
+
+//! Zobrist hashing of a board game state.
+//!
+//! A state is hashed by XOR-ing together a random key for each piece on each square, plus a key if it is Bob's turn. Since XOR is
+//! its own inverse, the hash of a response can be computed from the hash of the state in O(1) by XOR-ing the keys of the squares
+//! that changed, instead of hashing the whole board again.
+//!
+//! The keys are generated at compile time, so the tables are constant data with no initialization cost.
+//!
+//! Example:
+//!
+//!     using Hash = ZobristHash<64, 12>; // 64 squares, 12 kinds of pieces
+//!
+//!     // In the response generator:
+//!     uint64_t fingerprint = state.cachedFingerprint();
+//!     fingerprint = Hash::move(fingerprint, piece, from, to);
+//!     fingerprint = Hash::toggleTurn(fingerprint);
+//!     response->setCachedFingerprint(fingerprint);
+//!
+//! @param  SQUARES     Number of squares on the board
+//! @param  PIECES      Number of kinds of pieces (not including "empty")
+//! @param  SEED        Seed of the keys. Different seeds generate unrelated keys.
+
+template <size_t SQUARES, size_t PIECES, uint64_t SEED = 0x5a0b415d6f1c2e37ULL>
+class ZobristHash
+{
+public:
+    //! Value of an empty square passed to compute()
+    static int constexpr EMPTY = -1;
+
+    //! Returns the key of a piece on a square.
+    static constexpr uint64_t key(int piece, size_t square) { return KEYS[square * PIECES + (size_t)piece]; }
+
+    //! Returns the key that is included when it is Bob's turn.
+    static constexpr uint64_t turnKey() { return KEYS[SQUARES * PIECES]; }
+
+    //! Returns the hash after adding a piece to, or removing a piece from, a square.
+    static constexpr uint64_t toggle(uint64_t hash, int piece, size_t square) { return hash ^ key(piece, square); }
+
+    //! Returns the hash after moving a piece from one square to another.
+    static constexpr uint64_t move(uint64_t hash, int piece, size_t from, size_t to)
+    {
+        return hash ^ key(piece, from) ^ key(piece, to);
+    }
+
+    //! Returns the hash after the turn changes.
+    static constexpr uint64_t toggleTurn(uint64_t hash) { return hash ^ turnKey(); }
+
+    //! Computes the hash of a whole board.
+    //!
+    //! @param  pieceAt     Function object returning the piece on the given square, or EMPTY
+    //! @param  bobsTurn    True if it is Bob's turn
+    template <typename PieceAt>
+    static constexpr uint64_t compute(PieceAt pieceAt, bool bobsTurn)
+    {
+        uint64_t hash = bobsTurn ? turnKey() : 0;
+        for (size_t square = 0; square < SQUARES; ++square)
+        {
+            int piece = pieceAt(square);
+            if (piece != EMPTY)
+                hash ^= key(piece, square);
+        }
+        return hash;
+    }
+
+private:
+    // The SplitMix64 generator. It is simple enough to run at compile time and its output passes BigCrush.
+    static constexpr uint64_t splitMix64(uint64_t & state)
+    {
+        state += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = state;
+        z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z          = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    static constexpr std::array<uint64_t, SQUARES * PIECES + 1> generateKeys()
+    {
+        std::array<uint64_t, SQUARES * PIECES + 1> keys{};
+        uint64_t                                   state = SEED;
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            keys[i] = splitMix64(state);
+        }
+        return keys;
+    }
+
+    static constexpr std::array<uint64_t, SQUARES * PIECES + 1> KEYS = generateKeys();
+};
+
+} // namespace GamePlayer
@@ -0,0 +1,160 @@
+#pragma once
+
+// A minimal tic-tac-toe implementation used to exercise the search engines. Alice plays X and Bob plays O.
+
+#include "GamePlayer/GameState.h"
+#include "GamePlayer/StaticEvaluator.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace TicTacToe
+{
+using GamePlayer::GameState;
+
+int const EMPTY = 0;
+int const X     = 1;
+int const O     = 2;
+
+class State : public GameState
+{
+public:
+    State() { board_.fill(EMPTY); }
+
+    //! Creates a state from a 9-character string of 'X', 'O' and '.', in row order
+    explicit State(char const * squares)
+    {
+        int count = 0;
+        for (int i = 0; i < 9; ++i)
+        {
+            board_[i] = (squares[i] == 'X') ? X : (squares[i] == 'O') ? O : EMPTY;
+            count += (board_[i] != EMPTY);
+        }
+        turn_ = (count % 2 == 0) ? PlayerId::ALICE : PlayerId::BOB;
+    }
+
+    uint64_t fingerprint() const override
+    {
+        uint64_t code = 0;
+        for (int square : board_)
+            code = code * 3 + square;
+        code = code * 2 + (int)turn_;
+
+        // Mix the bits so that the fingerprint is uniformly distributed
+        code += 0x9e3779b97f4a7c15ULL;
+        code = (code ^ (code >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        code = (code ^ (code >> 27)) * 0x94d049bb133111ebULL;
+        return code ^ (code >> 31);
+    }
+
+    PlayerId whoseTurn() const override { return turn_; }
+
+    int square(int i) const { return board_[i]; }
+
+    //! Returns X or O if that player has three in a row, otherwise EMPTY
+    int winner() const
+    {
+        static int const LINES[8][3] = {{0, 1, 2}, {3, 4, 5}, {6, 7, 8}, {0, 3, 6}, {1, 4, 7}, {2, 5, 8}, {0, 4, 8}, {2, 4, 6}};
+        for (auto const & line : LINES)
+        {
+            int a = board_[line[0]];
+            if (a != EMPTY && a == board_[line[1]] && a == board_[line[2]])
+                return a;
+        }
+        return EMPTY;
+    }
+
+    bool isFull() const
+    {
+        for (int square : board_)
+        {
+            if (square == EMPTY)
+                return false;
+        }
+        return true;
+    }
+
+    //! Returns the state after the player whose turn it is marks the given square
+    State * play(int i) const
+    {
+        State * next    = new State(*this);
+        next->board_[i] = (turn_ == PlayerId::ALICE) ? X : O;
+        next->turn_     = (turn_ == PlayerId::ALICE) ? PlayerId::BOB : PlayerId::ALICE;
+        next->response_ = nullptr;
+        return next;
+    }
+
+    //! Returns the state after the player whose turn it is passes. Passing is not legal in tic-tac-toe, but it is useful for
+    //! exercising null-move pruning.
+    State * pass() const
+    {
+        State * next    = new State(*this);
+        next->turn_     = (turn_ == PlayerId::ALICE) ? PlayerId::BOB : PlayerId::ALICE;
+        next->response_ = nullptr;
+        return next;
+    }
+
+    //! Returns the index of the square that differs from the given state, or -1
+    int moveFrom(State const & previous) const
+    {
+        for (int i = 0; i < 9; ++i)
+        {
+            if (board_[i] != previous.board_[i])
+                return i;
+        }
+        return -1;
+    }
+
+private:
+    std::array<int, 9> board_;
+    PlayerId           turn_ = PlayerId::ALICE;
+};
+
+class Evaluator : public GamePlayer::StaticEvaluator
+{
+public:
+    static float constexpr ALICE_WINS = 100.0f;
+    static float constexpr BOB_WINS   = -100.0f;
+
+    float evaluate(GameState const & state) const override
+    {
+        State const & s = static_cast<State const &>(state);
+        int           w = s.winner();
+        if (w == X)
+            return ALICE_WINS;
+        if (w == O)
+            return BOB_WINS;
+
+        // Prefer the center, then the corners
+        static int const WEIGHTS[9] = {3, 2, 3, 2, 4, 2, 3, 2, 3};
+        float            value      = 0.0f;
+        for (int i = 0; i < 9; ++i)
+        {
+            if (s.square(i) == X)
+                value += WEIGHTS[i];
+            else if (s.square(i) == O)
+                value -= WEIGHTS[i];
+        }
+        return value;
+    }
+
+    float aliceWinsValue() const override { return ALICE_WINS; }
+    float bobWinsValue() const override { return BOB_WINS; }
+};
+
+//! Response generator. There are no responses once the game is over.
+inline std::vector<GameState *> responses(GameState const & state, int /*depth*/)
+{
+    State const &            s = static_cast<State const &>(state);
+    std::vector<GameState *> rv;
+    if (s.winner() != EMPTY)
+        return rv;
+    for (int i = 0; i < 9; ++i)
+    {
+        if (s.square(i) == EMPTY)
+            rv.push_back(s.play(i));
+    }
+    return rv;
+}
+} // namespace TicTacToe
@@ -0,0 +1,156 @@
+#include "GamePlayer/CompactTranspositionTable.h"
+#include "GamePlayer/StaticEvaluator.h"
+
+#include "gtest/gtest.h"
+
+using namespace GamePlayer;
+
+namespace
+{
+class RangeEvaluator : public StaticEvaluator
+{
+public:
+    float evaluate(GameState const &) const override { return 0.0f; }
+    float aliceWinsValue() const override { return 100.0f; }
+    float bobWinsValue() const override { return -50.0f; }
+};
+} // anonymous namespace
+
+TEST(GamePlayer_CompactTranspositionTableTest, MissWhenEmpty)
+{
+    RangeEvaluator            sef;
+    CompactTranspositionTable tt(1024, 4, sef);
+    EXPECT_FALSE(tt.check(0x0123456789abcdefULL));
+}
+
+TEST(GamePlayer_CompactTranspositionTableTest, ValuesAreQuantized)
+{
+    RangeEvaluator            sef;
+    CompactTranspositionTable tt(1024, 4, sef);
+
+    // Note: Values within 1/256 of the range from either end are wins/losses (see MateDistance)
+    float const values[] = {-49.4f, -12.345f, 0.0f, 25.0f, 33.3333f, 99.4f};
+    uint64_t    fp       = 0x1000000000000001ULL;
+    for (float v : values)
+    {
+        tt.set(fp, v, 3);
+        auto result = tt.check(fp);
+        ASSERT_TRUE(result);
+        EXPECT_NEAR(result->first, v, tt.maxQuantizationError());
+        EXPECT_EQ(result->second, 3);
+        // A value that is not a win must not be turned into one
+        EXPECT_LT(result->first, sef.aliceWinsValue());
+        EXPECT_GT(result->first, sef.bobWinsValue());
+    }
+}
+
+TEST(GamePlayer_CompactTranspositionTableTest, WinValuesAreExact)
+{
+    RangeEvaluator            sef;
+    CompactTranspositionTable tt(1024, 4, sef);
+
+    tt.set(1, sef.aliceWinsValue(), 0);
+    tt.set(2, sef.bobWinsValue(), 0);
+    EXPECT_EQ(tt.check(1)->first, sef.aliceWinsValue());
+    EXPECT_EQ(tt.check(2)->first, sef.bobWinsValue());
+}
+
+TEST(GamePlayer_CompactTranspositionTableTest, WinDistancesAreExact)
+{
+    RangeEvaluator            sef;
+    CompactTranspositionTable tt(1024, 4, sef);
+    MateDistance              md(sef);
+
+    for (int plies : {1, 2, 7, MateDistance::MAX_DISTANCE})
+    {
+        tt.set(1, md.aliceWinsIn(plies), 0);
+        tt.set(2, md.bobWinsIn(plies), 0);
+        EXPECT_EQ(tt.check(1)->first, md.aliceWinsIn(plies));
+        EXPECT_EQ(tt.check(2)->first, md.bobWinsIn(plies));
+    }
+}
+
+TEST(GamePlayer_CompactTranspositionTableTest, PartialKeyRejectsOtherStates)
+{
+    RangeEvaluator            sef;
+    CompactTranspositionTable tt(1024, 4, sef);
+
+    // Same slot, different upper bits
+    uint64_t a = 0x0000000100000005ULL;
+    uint64_t b = a + (1024ULL << 32);
+    ASSERT_NE(a >> 32, b >> 32);
+    tt.set(a, 1.0f, 0);
+    EXPECT_TRUE(tt.check(a));
+    EXPECT_FALSE(tt.check(b));
+}
+
+TEST(GamePlayer_CompactTranspositionTableTest, UpdateHonorsQuality)
+{
+    RangeEvaluator            sef;
+    CompactTranspositionTable tt(1024, 4, sef);
+
+    tt.update(7, 10.0f, 5);
+    tt.update(7, 20.0f, 4);
+    EXPECT_NEAR(tt.check(7)->first, 10.0f, tt.maxQuantizationError());
+    tt.update(7, 20.0f, 5);
+    EXPECT_NEAR(tt.check(7)->first, 20.0f, tt.maxQuantizationError());
+
+    EXPECT_TRUE(tt.check(7, 5));
+    EXPECT_FALSE(tt.check(7, 6));
+}
+
+TEST(GamePlayer_CompactTranspositionTableTest, OldEntriesAreRemoved)
+{
+    RangeEvaluator            sef;
+    CompactTranspositionTable tt(1024, 2, sef);
+
+    tt.set(9, 1.0f, 0);
+    tt.age();
+    tt.age();
+    EXPECT_TRUE(tt.check(9)); // Resets the age
+    tt.age();
+    tt.age();
+    tt.age();
+    EXPECT_FALSE(tt.check(9));
+}
+
+TEST(GamePlayer_CompactTranspositionTableTest, SizeFromMemoryBudget)
+{
+    RangeEvaluator            sef;
+    CompactTranspositionTable tt(MemoryBudget{3 << 20}, 4, sef);
+    EXPECT_EQ(tt.size(), size_t(1) << 18);
+    EXPECT_LE(tt.bytes(), size_t(3) << 20);
+}
+
+TEST(GamePlayer_CompactTranspositionTableTest, ShrinkingKeepsEntries)
+{
+    RangeEvaluator            sef;
+    CompactTranspositionTable tt(4096, 4, sef);
+    uint64_t const            fp = 0x123456789abcdef1ULL;
+    tt.set(fp, 10.0f, 3);
+
+    // The slot in the smaller table is implied by the slot in the larger table
+    tt.resize(1024);
+    ASSERT_TRUE(tt.check(fp));
+    EXPECT_NEAR(tt.check(fp)->first, 10.0f, tt.maxQuantizationError());
+    EXPECT_EQ(tt.check(fp)->second, 3);
+
+    // Growing requires bits of the fingerprint that are not stored, so the entries are dropped
+    tt.resize(4096);
+    EXPECT_FALSE(tt.check(fp));
+}
+
+TEST(GamePlayer_CompactTranspositionTableTest, ClearAndOccupancy)
+{
+    RangeEvaluator            sef;
+    CompactTranspositionTable tt(1 << 12, 4, sef);
+    for (uint64_t i = 0; i < tt.size() / 4; ++i)
+    {
+        tt.set(i, 0.0f, 0);
+    }
+    EXPECT_EQ(tt.occupancy(tt.size()), 0.25f);
+
+    tt.clear();
+    EXPECT_EQ(tt.occupancy(tt.size()), 0.0f);
+    EXPECT_FALSE(tt.check(1));
+}
@@ -0,0 +1,396 @@
+#include "TicTacToe.h"
+
+#include "GamePlayer/CompactTranspositionTable.h"
+#include "GamePlayer/GameTree.h"
+#include "GamePlayer/MateDistance.h"
+#include "GamePlayer/TranspositionTable.h"
+
+#include "gtest/gtest.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+using namespace GamePlayer;
+
+namespace
+{
+GameTree makeTree(int maxDepth)
+{
+    return GameTree(std::make_shared<TranspositionTable>(1 << 16, 4),
+                    std::make_shared<TicTacToe::Evaluator>(),
+                    TicTacToe::responses,
+                    maxDepth);
+}
+
+// A game played on a graph, in which states can repeat. Each vertex is a state.
+namespace Graph
+{
+struct Vertex
+{
+    GameState::PlayerId turn;
+    float               value;
+    std::vector<int>    edges; // Responses
+};
+
+// From A, Alice can only move to B or lose at C. From B, Bob can only return to A or lose at D. From X, Alice can move to Y or Z,
+// and the game ends.
+enum
+{
+    A,
+    B,
+    C,
+    D,
+    X,
+    Y,
+    Z
+};
+std::vector<Vertex> const VERTICES = {{GameState::PlayerId::ALICE, 10.0f, {B, C}},
+                                      {GameState::PlayerId::BOB, 0.0f, {A, D}},
+                                      {GameState::PlayerId::BOB, -100.0f, {}},
+                                      {GameState::PlayerId::ALICE, 100.0f, {}},
+                                      {GameState::PlayerId::ALICE, 0.0f, {Y, Z}},
+                                      {GameState::PlayerId::BOB, 30.0f, {}},
+                                      {GameState::PlayerId::BOB, 20.0f, {}}};
+
+class State : public GameState
+{
+public:
+    explicit State(int vertex)
+        : vertex(vertex)
+    {
+    }
+
+    uint64_t fingerprint() const override { return 0x9e3779b97f4a7c15ULL * (uint64_t)(vertex + 1); }
+    PlayerId whoseTurn() const override { return VERTICES[vertex].turn; }
+
+    int vertex;
+};
+
+class Evaluator : public StaticEvaluator
+{
+public:
+    float evaluate(GameState const & state) const override { return VERTICES[static_cast<State const &>(state).vertex].value; }
+    float aliceWinsValue() const override { return 100.0f; }
+    float bobWinsValue() const override { return -100.0f; }
+};
+
+std::vector<GameState *> responses(GameState const & state, int /*depth*/)
+{
+    std::vector<GameState *> rv;
+    for (int v : VERTICES[static_cast<State const &>(state).vertex].edges)
+    {
+        rv.push_back(new State(v));
+    }
+    return rv;
+}
+} // namespace Graph
+
+// A second configuration of the game tree, used in the same program as GameTree
+class FinalEvaluator final : public TicTacToe::Evaluator
+{
+};
+
+struct CompactPolicies : GameTreeFeatures
+{
+    using TranspositionTable = CompactTranspositionTable;
+    using Evaluator          = FinalEvaluator;
+    using MoveOrdering       = NoOrdering;
+    using Statistics         = GameTreeAnalysisData;
+    static bool constexpr NULL_MOVE_PRUNING    = false;
+    static bool constexpr REPETITION_DETECTION = false;
+    static bool constexpr SEARCH_TRACE         = false;
+    static bool constexpr PHASE_TIMING         = false;
+};
+using CompactGameTree = BasicGameTree<CompactPolicies>;
+
+// The same configuration with all of the features
+struct FullCompactPolicies : GameTreeFeatures
+{
+    using TranspositionTable = CompactPolicies::TranspositionTable;
+    using Evaluator          = CompactPolicies::Evaluator;
+    using MoveOrdering       = CompactPolicies::MoveOrdering;
+    using Statistics         = CompactPolicies::Statistics;
+};
+using FullCompactGameTree = BasicGameTree<FullCompactPolicies>;
+
+// A configuration without a T-table
+struct NoTablePolicies : CompactPolicies
+{
+    static bool constexpr TRANSPOSITION_TABLE_LOOKUPS = false;
+};
+using NoTableGameTree = BasicGameTree<NoTablePolicies>;
+
+// The default configuration, but with statistics regardless of the build options
+struct AnalyzedPolicies : DefaultGameTreePolicies
+{
+    using Statistics = GameTreeAnalysisData;
+};
+using AnalyzedGameTree = BasicGameTree<AnalyzedPolicies>;
+
+AnalyzedGameTree makeAnalyzedTree(int maxDepth)
+{
+    return AnalyzedGameTree(std::make_shared<TranspositionTable>(1 << 16, 4),
+                            std::make_shared<TicTacToe::Evaluator>(),
+                            TicTacToe::responses,
+                            maxDepth);
+}
+
+MateDistance mateDistance()
+{
+    return MateDistance(TicTacToe::Evaluator());
+}
+
+template <typename Tree>
+int bestMove(Tree const & tree, char const * board, float * value = nullptr)
+{
+    std::shared_ptr<GameState> s0 = std::make_shared<TicTacToe::State>(board);
+    float                      v  = tree.findBestResponse(s0);
+    if (value)
+        *value = v;
+    if (!s0->response_)
+        return -1;
+    return static_cast<TicTacToe::State const &>(*s0->response_).moveFrom(static_cast<TicTacToe::State const &>(*s0));
+}
+} // anonymous namespace
+
+TEST(GamePlayer_GameTreeTest, AliceTakesTheWin)
+{
+    float value;
+    EXPECT_EQ(bestMove(makeTree(4), "XX.OO....", &value), 2);
+    EXPECT_EQ(value, mateDistance().aliceWinsIn(1));
+}
+
+TEST(GamePlayer_GameTreeTest, BobTakesTheWin)
+{
+    float value;
+    EXPECT_EQ(bestMove(makeTree(4), "XX.OO.X..", &value), 5);
+    EXPECT_EQ(value, mateDistance().bobWinsIn(1));
+}
+
+TEST(GamePlayer_GameTreeTest, BobBlocks)
+{
+    EXPECT_EQ(bestMove(makeTree(4), "XX..O....", nullptr), 2);
+}
+
+TEST(GamePlayer_GameTreeTest, PerfectPlayIsADraw)
+{
+    float value;
+    bestMove(makeTree(9), ".........", &value);
+    EXPECT_FALSE(mateDistance().isAliceWin(value));
+    EXPECT_FALSE(mateDistance().isBobWin(value));
+}
+
+TEST(GamePlayer_GameTreeTest, WinValuesIncludeTheDistance)
+{
+    // Alice's only win is a fork, which wins on her next move
+    float value;
+    EXPECT_EQ(bestMove(makeTree(5), "XO..X...O", &value), 6);
+    EXPECT_EQ(value, mateDistance().aliceWinsIn(3));
+    EXPECT_EQ(mateDistance().distance(value), 3);
+
+    // The T-table stores the distance from the state, so a search of the response finds the same win one ply closer
+    GameTree                   tree = makeTree(5);
+    std::shared_ptr<GameState> s0   = std::make_shared<TicTacToe::State>("XO..X...O");
+    tree.findBestResponse(s0);
+    std::shared_ptr<GameState> s1 = s0->response_;
+    EXPECT_EQ(tree.findBestResponse(s1), mateDistance().aliceWinsIn(2));
+}
+
+TEST(GamePlayer_GameTreeTest, SelectiveSearchFindsTheWin)
+{
+    GameTree tree = makeTree(6);
+    tree.setLateMoveReductions(2, 1);
+    tree.setNullMovePruning([](GameState const & state) { return static_cast<TicTacToe::State const &>(state).pass(); }, 1);
+
+    float value;
+    EXPECT_EQ(bestMove(tree, "XX.OO....", &value), 2);
+    EXPECT_EQ(value, mateDistance().aliceWinsIn(1));
+    EXPECT_EQ(bestMove(tree, "XX..O....", nullptr), 2);
+}
+
+TEST(GamePlayer_GameTreeTest, MultiPvValuesAreExact)
+{
+    for (char const * board : {"X...O....", "X...O...X"})
+    {
+        // Compute the exact value of every response by searching each one separately
+        TicTacToe::State         s(board);
+        std::vector<float>       expected;
+        std::vector<GameState *> responses = TicTacToe::responses(s, 0);
+        for (GameState * response : responses)
+        {
+            std::shared_ptr<GameState> r(response);
+            expected.push_back(makeTree(3).findBestResponse(r));
+        }
+        if (s.whoseTurn() == GameState::PlayerId::ALICE)
+            std::sort(expected.begin(), expected.end(), std::greater<float>());
+        else
+            std::sort(expected.begin(), expected.end());
+
+        std::shared_ptr<GameState>            s0   = std::make_shared<TicTacToe::State>(board);
+        std::vector<GameTree::ScoredResponse> best = makeTree(4).findBestResponses(s0, 3);
+        ASSERT_EQ(best.size(), 3u);
+        EXPECT_EQ(s0->response_, best[0].state);
+        for (size_t i = 0; i < best.size(); ++i)
+        {
+            EXPECT_FLOAT_EQ(best[i].value, expected[i]) << board << " #" << i;
+            std::shared_ptr<GameState> r = best[i].state;
+            EXPECT_FLOAT_EQ(makeTree(3).findBestResponse(r), best[i].value) << board << " #" << i;
+        }
+
+        // The best value matches a normal search
+        std::shared_ptr<GameState> s1 = std::make_shared<TicTacToe::State>(board);
+        EXPECT_FLOAT_EQ(makeTree(4).findBestResponse(s1), best[0].value);
+    }
+}
+
+TEST(GamePlayer_GameTreeTest, MultiPvReturnsAllResponsesIfThereAreFewer)
+{
+    std::shared_ptr<GameState> s0 = std::make_shared<TicTacToe::State>("XOXXOOOX.");
+    EXPECT_EQ(makeTree(4).findBestResponses(s0, 3).size(), 1u);
+}
+
+TEST(GamePlayer_GameTreeTest, RepetitionIsADraw)
+{
+    float const DRAW = -5.0f;
+
+    auto                       tt = std::make_shared<TranspositionTable>(1 << 10, 4);
+    GameTree                   tree(tt, std::make_shared<Graph::Evaluator>(), Graph::responses, 6);
+    std::shared_ptr<GameState> s0 = std::make_shared<Graph::State>(Graph::A);
+
+    // Without repetition detection, the cycle between A and B is searched until the maximum depth
+    EXPECT_NE(tree.findBestResponse(s0), DRAW);
+
+    // Bob's best response to B is to repeat A
+    tt   = std::make_shared<TranspositionTable>(1 << 10, 4);
+    tree = GameTree(tt, std::make_shared<Graph::Evaluator>(), Graph::responses, 6);
+    tree.setRepetitionDetection(true, DRAW);
+    EXPECT_EQ(tree.findBestResponse(s0), DRAW);
+    EXPECT_EQ(static_cast<Graph::State const &>(*s0->response_).vertex, Graph::B);
+
+    // The values of A and B depend on the path, so they were not saved
+    EXPECT_FALSE(tt->check(Graph::State(Graph::A).fingerprint()));
+    EXPECT_EQ(tt->check(Graph::State(Graph::B).fingerprint())->second, 0); // Only the static evaluation
+}
+
+TEST(GamePlayer_GameTreeTest, GameHistoryIsPartOfThePath)
+{
+    float const DRAW = -5.0f;
+
+    GameTree tree(std::make_shared<TranspositionTable>(1 << 10, 4), std::make_shared<Graph::Evaluator>(), Graph::responses, 2);
+    tree.setRepetitionDetection(true, DRAW);
+
+    // Y is better than Z, unless it repeats an earlier state in the game
+    std::shared_ptr<GameState> s0 = std::make_shared<Graph::State>(Graph::X);
+    EXPECT_EQ(tree.findBestResponse(s0), 30.0f);
+
+    tree.setGameHistory({Graph::State(Graph::Y).fingerprint()});
+    std::shared_ptr<GameState> s1 = std::make_shared<Graph::State>(Graph::X);
+    EXPECT_EQ(tree.findBestResponse(s1), 20.0f);
+    EXPECT_EQ(static_cast<Graph::State const &>(*s1->response_).vertex, Graph::Z);
+}
+
+TEST(GamePlayer_GameTreeTest, PhaseTiming)
+{
+    using PhaseTimes = GameTree::PhaseTimes;
+
+    // Nothing is timed unless timing is enabled
+    GameTree tree = makeTree(4);
+    bestMove(tree, "X...O....");
+    EXPECT_EQ(tree.phaseTimes_.searchCycles, 0u);
+    EXPECT_EQ(tree.phaseTimes_.counts[0][PhaseTimes::GENERATE], 0u);
+
+    tree = makeTree(4); // Use an empty T-table, so that the responses to the root are evaluated
+    tree.setPhaseTiming(true);
+    bestMove(tree, "X...O....");
+    EXPECT_GT(tree.phaseTimes_.searchNanoseconds, 0u);
+    EXPECT_EQ(tree.phaseTimes_.counts[0][PhaseTimes::GENERATE], 1u);
+    EXPECT_EQ(tree.phaseTimes_.counts[0][PhaseTimes::SORT], 1u);
+    EXPECT_GT(tree.phaseTimes_.counts[0][PhaseTimes::EVALUATE], 0u);
+    EXPECT_GT(tree.phaseTimes_.counts[1][PhaseTimes::TRANSPOSITION_TABLE], 0u);
+
+    // The phases are part of the search
+    uint64_t total = 0;
+    for (size_t d = 0; d < PhaseTimes::MAX_DEPTH; ++d)
+    {
+        for (int p = 0; p < PhaseTimes::NUM_PHASES; ++p)
+            total += tree.phaseTimes_.cycles[d][p];
+    }
+    EXPECT_LE(total, tree.phaseTimes_.searchCycles);
+
+    nlohmann::json json = tree.phaseTimes_.toJson();
+    EXPECT_EQ(json["generate"]["counts"][0], 1);
+
+    tree.phaseTimes_.reset();
+    EXPECT_EQ(tree.phaseTimes_.searchCycles, 0u);
+}
+
+TEST(GamePlayer_GameTreeTest, PoliciesSelectTheConfiguration)
+{
+    auto            sef = std::make_shared<FinalEvaluator>();
+    CompactGameTree tree(std::make_shared<CompactTranspositionTable>(1 << 16, 4, *sef), sef, TicTacToe::responses, 4);
+
+    // The search is the same, but with a different T-table and without sorting
+    std::shared_ptr<GameState> s0    = std::make_shared<TicTacToe::State>("XX.OO....");
+    float                      value = tree.findBestResponse(s0);
+    ASSERT_TRUE(s0->response_);
+    EXPECT_EQ(static_cast<TicTacToe::State const &>(*s0->response_).moveFrom(static_cast<TicTacToe::State const &>(*s0)), 2);
+    EXPECT_EQ(value, mateDistance().aliceWinsIn(1));
+    EXPECT_EQ(bestMove(makeTree(4), "XX.OO....", nullptr), 2);
+
+    // The statistics are collected regardless of the build options
+    EXPECT_EQ(tree.analysisData_.value, value);
+    EXPECT_EQ(tree.analysisData_.generatedCounts[0], 5);
+
+    // Features disabled by the policies take no space (and their setters do not compile)
+    EXPECT_LT(sizeof(CompactGameTree), sizeof(FullCompactGameTree));
+}
+
+TEST(GamePlayer_GameTreeTest, PoliciesCanRemoveTheTranspositionTable)
+{
+    NoTableGameTree tree(nullptr, std::make_shared<FinalEvaluator>(), TicTacToe::responses, 4);
+
+    std::shared_ptr<GameState> s0    = std::make_shared<TicTacToe::State>("XX..O....");
+    float                      value = tree.findBestResponse(s0);
+    ASSERT_TRUE(s0->response_);
+    EXPECT_EQ(static_cast<TicTacToe::State const &>(*s0->response_).moveFrom(static_cast<TicTacToe::State const &>(*s0)), 2);
+
+    // Without a T-table, every generated state is evaluated
+    int generated = 0;
+    int evaluated = 0;
+    for (size_t d = 0; d < GameTreeAnalysisData::MAX_DEPTH; ++d)
+    {
+        generated += tree.analysisData_.generatedCounts[d];
+        evaluated += tree.analysisData_.evaluatedCounts[d];
+    }
+    EXPECT_EQ(evaluated, generated);
+    EXPECT_FALSE(mateDistance().isAliceWin(value));
+}
+
+TEST(GamePlayer_GameTreeTest, LateMoveReductionsReduceTheBranchingFactor)
+{
+    AnalyzedGameTree full = makeAnalyzedTree(7);
+    bestMove(full, "....X....");
+    float fullEbf = full.analysisData_.effectiveBranchingFactor();
+
+    AnalyzedGameTree reduced = makeAnalyzedTree(7);
+    reduced.setLateMoveReductions(2, 2);
+    bestMove(reduced, "....X....");
+    float reducedEbf = reduced.analysisData_.effectiveBranchingFactor();
+
+    EXPECT_GT(reduced.analysisData_.lateMoveReductions, 0);
+    EXPECT_LT(reducedEbf, fullEbf);
+    EXPECT_TRUE(reduced.analysisData_.toJson().contains("effectiveBranchingFactor"));
+}
+
+TEST(GamePlayer_GameTreeTest, MateDistancePruningCutsLongerWins)
+{
+    AnalyzedGameTree tree = makeAnalyzedTree(9);
+    float            value;
+    EXPECT_EQ(bestMove(tree, "XO..X...O", &value), 6);
+    EXPECT_EQ(value, mateDistance().aliceWinsIn(3));
+    EXPECT_GT(tree.analysisData_.mateDistanceCutoffs, 0);
+    EXPECT_TRUE(tree.analysisData_.toJson().contains("mateDistanceCutoffs"));
+}
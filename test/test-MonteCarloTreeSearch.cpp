@@ -0,0 +1,90 @@
+#include "TicTacToe.h"
+
+#include "GamePlayer/MonteCarloTreeSearch.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+using namespace GamePlayer;
+
+namespace
+{
+// The searches are limited by iterations, so the results do not depend on the speed of the machine
+MonteCarloTreeSearch::Options options(MonteCarloTreeSearch::Selection selection, int threads, int rolloutDepth)
+{
+    MonteCarloTreeSearch::Options o;
+    o.selection     = selection;
+    o.threads       = threads;
+    o.rolloutDepth  = rolloutDepth;
+    o.maxIterations = 20000;
+    return o;
+}
+
+int bestMove(MonteCarloTreeSearch const & mcts, char const * board, float * value = nullptr)
+{
+    std::shared_ptr<GameState> s0 = std::make_shared<TicTacToe::State>(board);
+    float                      v  = mcts.findBestResponse(s0, std::chrono::milliseconds(10000));
+    if (value)
+        *value = v;
+    if (!s0->response_)
+        return -1;
+    return static_cast<TicTacToe::State const &>(*s0->response_).moveFrom(static_cast<TicTacToe::State const &>(*s0));
+}
+} // anonymous namespace
+
+TEST(GamePlayer_MonteCarloTreeSearchTest, PuctTakesTheWinAndBlocks)
+{
+    MonteCarloTreeSearch mcts(std::make_shared<TicTacToe::Evaluator>(),
+                              TicTacToe::responses,
+                              options(MonteCarloTreeSearch::Selection::PUCT, 1, 0));
+    float                value;
+    EXPECT_EQ(bestMove(mcts, "XX.OO....", &value), 2);
+    EXPECT_GT(value, 0.0f);
+    EXPECT_EQ(bestMove(mcts, "XX..O...."), 2);
+}
+
+TEST(GamePlayer_MonteCarloTreeSearchTest, UctWithRolloutsTakesTheWinAndBlocks)
+{
+    MonteCarloTreeSearch mcts(std::make_shared<TicTacToe::Evaluator>(),
+                              TicTacToe::responses,
+                              options(MonteCarloTreeSearch::Selection::UCT, 1, 4));
+    EXPECT_EQ(bestMove(mcts, "XX.OO...."), 2);
+    EXPECT_EQ(bestMove(mcts, "XX..O...."), 2);
+}
+
+TEST(GamePlayer_MonteCarloTreeSearchTest, ParallelSearchTakesTheWinAndBlocks)
+{
+    MonteCarloTreeSearch mcts(std::make_shared<TicTacToe::Evaluator>(),
+                              TicTacToe::responses,
+                              options(MonteCarloTreeSearch::Selection::PUCT, 4, 0));
+    EXPECT_EQ(bestMove(mcts, "XX.OO...."), 2);
+    EXPECT_EQ(bestMove(mcts, "XX..O...."), 2);
+}
+
+TEST(GamePlayer_MonteCarloTreeSearchTest, NoResponseWhenTheGameIsOver)
+{
+    MonteCarloTreeSearch mcts(std::make_shared<TicTacToe::Evaluator>(), TicTacToe::responses);
+    EXPECT_EQ(bestMove(mcts, "XXXOO...."), -1);
+}
+
+TEST(GamePlayer_MonteCarloTreeSearchTest, NoResponseWhenTheBoardIsFull)
+{
+    // The game is a draw, so the root is not a win/loss, but it has no responses. The search must not use up its budget.
+    MonteCarloTreeSearch       mcts(std::make_shared<TicTacToe::Evaluator>(), TicTacToe::responses);
+    std::shared_ptr<GameState> s0    = std::make_shared<TicTacToe::State>("XOXXOOOXX");
+    auto                       start = std::chrono::steady_clock::now();
+    mcts.findBestResponse(s0, std::chrono::milliseconds(10000));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_EQ(s0->response_, nullptr);
+}
+
+TEST(GamePlayer_MonteCarloTreeSearchTest, ResponseWhenTheRootHasMoreResponsesThanTheNodeLimit)
+{
+    // The root has 9 responses, which is more than the tree may hold, but one of them must still be chosen
+    MonteCarloTreeSearch::Options o = options(MonteCarloTreeSearch::Selection::PUCT, 1, 0);
+    o.maxNodes                      = 4;
+    MonteCarloTreeSearch mcts(std::make_shared<TicTacToe::Evaluator>(), TicTacToe::responses, o);
+    EXPECT_NE(bestMove(mcts, "........."), -1);
+    EXPECT_EQ(bestMove(mcts, "XX.OO...."), 2);
+}
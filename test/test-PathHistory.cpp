@@ -0,0 +1,70 @@
+#include "GamePlayer/PathHistory.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace GamePlayer;
+
+TEST(GamePlayer_PathHistoryTest, ContainsOnlyThePath)
+{
+    PathHistory path;
+    EXPECT_FALSE(path.contains(1));
+
+    path.push(1);
+    path.push(2);
+    EXPECT_TRUE(path.contains(1));
+    EXPECT_TRUE(path.contains(2));
+    EXPECT_FALSE(path.contains(3));
+    EXPECT_EQ(path.size(), 2u);
+
+    path.pop();
+    EXPECT_TRUE(path.contains(1));
+    EXPECT_FALSE(path.contains(2));
+
+    path.clear();
+    EXPECT_FALSE(path.contains(1));
+    EXPECT_EQ(path.size(), 0u);
+}
+
+TEST(GamePlayer_PathHistoryTest, CollidingFingerprintsArePoppedInOrder)
+{
+    // These fingerprints all hash to the same slot, so they form a single probe sequence
+    PathHistory           path(4);
+    std::vector<uint64_t> fingerprints = {0x100, 0x200, 0x300, 0x200};
+    for (uint64_t f : fingerprints)
+    {
+        path.push(f);
+    }
+
+    path.pop();
+    EXPECT_TRUE(path.contains(0x200)); // The earlier copy remains
+    path.pop();
+    EXPECT_TRUE(path.contains(0x200));
+    EXPECT_FALSE(path.contains(0x300));
+    path.pop();
+    EXPECT_FALSE(path.contains(0x200));
+    EXPECT_TRUE(path.contains(0x100));
+}
+
+TEST(GamePlayer_PathHistoryTest, Grows)
+{
+    PathHistory path(2);
+    for (uint64_t f = 0; f < 1000; ++f)
+    {
+        path.push(f * 0x9e3779b97f4a7c15ULL);
+    }
+    EXPECT_EQ(path.size(), 1000u);
+    for (uint64_t f = 0; f < 1000; ++f)
+    {
+        EXPECT_TRUE(path.contains(f * 0x9e3779b97f4a7c15ULL));
+    }
+
+    for (int i = 0; i < 500; ++i)
+    {
+        path.pop();
+    }
+    EXPECT_TRUE(path.contains(499 * 0x9e3779b97f4a7c15ULL));
+    EXPECT_FALSE(path.contains(500 * 0x9e3779b97f4a7c15ULL));
+}
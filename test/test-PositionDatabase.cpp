@@ -0,0 +1,131 @@
+#include "TicTacToe.h"
+
+#include "GamePlayer/GameTree.h"
+#include "GamePlayer/MateDistance.h"
+#include "GamePlayer/PositionDatabase.h"
+#include "GamePlayer/TranspositionTable.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <filesystem>
+
+using namespace GamePlayer;
+
+namespace
+{
+std::string tempPath(char const * name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// A configuration other than GameTree
+struct NoDatabasePolicies : DefaultGameTreePolicies
+{
+    static bool constexpr POSITION_DATABASE = false;
+};
+} // anonymous namespace
+
+TEST(GamePlayer_PositionDatabaseTest, OpenFailsForMissingFile)
+{
+    EXPECT_EQ(PositionDatabase::open(tempPath("GamePlayer_does_not_exist.gpdb")), nullptr);
+}
+
+TEST(GamePlayer_PositionDatabaseTest, FindsEveryRecord)
+{
+    std::string path = tempPath("GamePlayer_FindsEveryRecord.gpdb");
+
+    // Random fingerprints from a simple generator
+    std::vector<PositionDatabase::Record> records;
+    uint64_t                              x = 1;
+    for (int i = 0; i < 10000; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        records.push_back(PositionDatabase::Record{x, x + 1, (float)i, i % 7});
+    }
+    // A duplicate with a lower quality is dropped
+    records.push_back(PositionDatabase::Record{records[0].fingerprint, 0, -1.0f, -1});
+
+    ASSERT_TRUE(PositionDatabase::write(path, records));
+    std::shared_ptr<PositionDatabase> db = PositionDatabase::open(path);
+    ASSERT_NE(db, nullptr);
+    EXPECT_EQ(db->size(), 10000u);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        auto record = db->find(records[i].fingerprint);
+        ASSERT_TRUE(record);
+        EXPECT_EQ(record->response, records[i].fingerprint + 1);
+        EXPECT_EQ(record->value, (float)i);
+    }
+    EXPECT_FALSE(db->find(0));
+    EXPECT_FALSE(db->find(12345));
+    EXPECT_FALSE(db->find(~0ULL));
+
+    db.reset();
+    std::remove(path.c_str());
+}
+
+TEST(GamePlayer_PositionDatabaseTest, GameTreeUsesTheDatabase)
+{
+    std::string path = tempPath("GamePlayer_GameTreeUsesTheDatabase.gpdb");
+
+    auto     sef = std::make_shared<TicTacToe::Evaluator>();
+    GameTree tree(std::make_shared<TranspositionTable>(1 << 16, 4), sef, TicTacToe::responses, 2);
+
+    // Claim that the best opening is the top-left corner with a bogus value. A search would never find this value.
+    TicTacToe::State                  start;
+    std::unique_ptr<TicTacToe::State> corner(start.play(0));
+    PositionDatabaseBuilder           builder(tree);
+    builder.add(PositionDatabase::Record{start.fingerprint(), corner->fingerprint(), 42.0f, 99});
+    ASSERT_TRUE(builder.write(path));
+
+    tree.setPositionDatabase(PositionDatabase::open(path));
+    std::shared_ptr<GameState> s0 = std::make_shared<TicTacToe::State>();
+    EXPECT_EQ(tree.findBestResponse(s0), 42.0f);
+    ASSERT_NE(s0->response_, nullptr);
+    EXPECT_EQ(s0->response_->fingerprint(), corner->fingerprint());
+
+    tree.setPositionDatabase(nullptr);
+    std::remove(path.c_str());
+}
+
+TEST(GamePlayer_PositionDatabaseTest, BuilderRecordsSearchResults)
+{
+    std::string path = tempPath("GamePlayer_BuilderRecordsSearchResults.gpdb");
+
+    GameTree deep(std::make_shared<TranspositionTable>(1 << 16, 4),
+                  std::make_shared<TicTacToe::Evaluator>(),
+                  TicTacToe::responses,
+                  9);
+    PositionDatabaseBuilder    builder(deep);
+    std::shared_ptr<GameState> s0 = std::make_shared<TicTacToe::State>("XX.OO....");
+    builder.add(s0);
+    ASSERT_TRUE(builder.write(path));
+
+    auto db     = PositionDatabase::open(path);
+    auto record = db->find(s0->fingerprint());
+    ASSERT_TRUE(record);
+    EXPECT_EQ(record->quality, 9);
+    EXPECT_EQ(record->value, MateDistance(TicTacToe::Evaluator()).aliceWinsIn(1));
+    EXPECT_EQ(record->response, s0->response_->fingerprint());
+
+    db.reset();
+    std::remove(path.c_str());
+}
+
+TEST(GamePlayer_PositionDatabaseTest, BuilderAcceptsAnyGameTree)
+{
+    // A configuration without the position database can still build one
+    BasicGameTree<NoDatabasePolicies> deep(std::make_shared<TranspositionTable>(1 << 16, 4),
+                                           std::make_shared<TicTacToe::Evaluator>(),
+                                           TicTacToe::responses,
+                                           9);
+    PositionDatabaseBuilder    builder(deep);
+    std::shared_ptr<GameState> s0 = std::make_shared<TicTacToe::State>("XX.OO....");
+    builder.add(s0);
+    ASSERT_EQ(builder.size(), 1u);
+    EXPECT_EQ(s0->response_->fingerprint(), TicTacToe::State("XXXOO....").fingerprint());
+}
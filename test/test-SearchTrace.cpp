@@ -0,0 +1,158 @@
+#include "TicTacToe.h"
+
+#include "GamePlayer/GameTree.h"
+#include "GamePlayer/SearchTrace.h"
+#include "GamePlayer/TranspositionTable.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace GamePlayer;
+
+namespace
+{
+std::vector<SearchTrace::Event> traceSearch(std::shared_ptr<SearchTrace> trace, char const * board)
+{
+    GameTree tree(std::make_shared<TranspositionTable>(1 << 16, 4), std::make_shared<TicTacToe::Evaluator>(), TicTacToe::responses, 4);
+    tree.setSearchTrace(trace);
+    std::shared_ptr<GameState> s0 = std::make_shared<TicTacToe::State>(board);
+    tree.findBestResponse(s0);
+    return trace->events();
+}
+
+// Returns the maximum nesting depth of the events, or -1 if enter and exit events are not properly nested
+int checkNesting(std::vector<SearchTrace::Event> const & events)
+{
+    std::vector<SearchTrace::Event> stack;
+    int                             maxDepth = 0;
+    for (auto const & event : events)
+    {
+        if (!(event.flags & SearchTrace::EXIT))
+        {
+            if ((int)event.depth != (int)stack.size())
+                return -1;
+            stack.push_back(event);
+            maxDepth = std::max(maxDepth, (int)stack.size());
+            continue;
+        }
+        if (stack.empty() || stack.back().fingerprint != event.fingerprint || stack.back().depth != event.depth ||
+            event.time < stack.back().time)
+        {
+            return -1;
+        }
+        stack.pop_back();
+    }
+    return stack.empty() ? maxDepth : -1;
+}
+} // anonymous namespace
+
+TEST(GamePlayer_SearchTraceTest, EventsAreNested)
+{
+    std::vector<SearchTrace::Event> events = traceSearch(SearchTrace::createRingBuffer(1 << 16), ".........");
+    ASSERT_FALSE(events.empty());
+
+    // The first event is the root being entered and the last is the root exiting
+    TicTacToe::State root(".........");
+    EXPECT_EQ(events.front().fingerprint, root.fingerprint());
+    EXPECT_EQ(events.front().depth, 0);
+    EXPECT_EQ(events.front().flags, 0);
+    EXPECT_EQ(events.back().fingerprint, root.fingerprint());
+    EXPECT_TRUE(events.back().flags & SearchTrace::EXIT);
+
+    int maxDepth = checkNesting(events);
+    EXPECT_GT(maxDepth, 1);
+}
+
+TEST(GamePlayer_SearchTraceTest, PerDepthCountsIncludeTheHorizon)
+{
+    // The search is 4 plies deep, so the states at ply 4 are only evaluated, never searched
+    std::vector<SearchTrace::Event> events = traceSearch(SearchTrace::createRingBuffer(1 << 20), "X...O....");
+    ASSERT_LT(events.size(), 1u << 20);
+    EXPECT_EQ(checkNesting(events), 5);
+
+    std::vector<int> nodes(5, 0);
+    std::vector<int> leaves(5, 0);
+    int              ttHits = 0;
+    for (auto const & event : events)
+    {
+        ASSERT_LT(event.depth, 5);
+        if (!(event.flags & SearchTrace::EXIT))
+            continue;
+        ++nodes[event.depth];
+        leaves[event.depth] += (event.flags & SearchTrace::LEAF) ? 1 : 0;
+        ttHits += (event.flags & SearchTrace::TT_HIT) ? 1 : 0;
+        if (event.flags & SearchTrace::TT_HIT)
+            EXPECT_TRUE(event.flags & SearchTrace::LEAF);
+    }
+
+    EXPECT_EQ(leaves[0], 0); // The root is searched
+    EXPECT_GT(nodes[4], 0);
+    EXPECT_EQ(leaves[4], nodes[4]);
+    EXPECT_GT(ttHits, 0);
+}
+
+TEST(GamePlayer_SearchTraceTest, RingBufferKeepsTheMostRecentEvents)
+{
+    std::vector<SearchTrace::Event> all    = traceSearch(SearchTrace::createRingBuffer(1 << 16), ".........");
+    std::vector<SearchTrace::Event> recent = traceSearch(SearchTrace::createRingBuffer(100), ".........");
+    ASSERT_GT(all.size(), 128u);
+    ASSERT_EQ(recent.size(), 128u); // The capacity is rounded up to a power of two
+
+    // The same search records the same states, so the tail of the full trace matches the ring buffer
+    for (size_t i = 0; i < recent.size(); ++i)
+    {
+        SearchTrace::Event const & expected = all[all.size() - recent.size() + i];
+        EXPECT_EQ(recent[i].fingerprint, expected.fingerprint);
+        EXPECT_EQ(recent[i].flags, expected.flags);
+    }
+}
+
+TEST(GamePlayer_SearchTraceTest, FileRoundTrip)
+{
+    std::string path = testing::TempDir() + "test-SearchTrace.gptr";
+
+    std::vector<SearchTrace::Event> expected = traceSearch(SearchTrace::createRingBuffer(1 << 16), "X...O....");
+    ASSERT_LT(expected.size(), 1u << 16);
+
+    // Stream a trace of the same search to a file. Destroying the trace flushes and closes the file.
+    {
+        std::shared_ptr<SearchTrace> trace = SearchTrace::createFile(path);
+        ASSERT_NE(trace, nullptr);
+        traceSearch(trace, "X...O....");
+        EXPECT_TRUE(trace->flush());
+    }
+
+    std::vector<SearchTrace::Event> events;
+    ASSERT_TRUE(SearchTrace::read(path, &events));
+    ASSERT_EQ(events.size(), expected.size());
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        EXPECT_EQ(events[i].fingerprint, expected[i].fingerprint);
+        EXPECT_EQ(events[i].depth, expected[i].depth);
+        EXPECT_EQ(events[i].flags, expected[i].flags);
+    }
+    EXPECT_GT(checkNesting(events), 1);
+    std::remove(path.c_str());
+}
+
+#if defined(__linux__)
+TEST(GamePlayer_SearchTraceTest, FlushReportsWriteFailures)
+{
+    // Every write to /dev/full fails, but the header is only buffered, so the failure is not seen until the first flush
+    std::shared_ptr<SearchTrace> trace = SearchTrace::createFile("/dev/full");
+    ASSERT_NE(trace, nullptr);
+    traceSearch(trace, "X...O....");
+    EXPECT_FALSE(trace->flush());
+    EXPECT_FALSE(trace->flush());
+}
+#endif // defined(__linux__)
+
+TEST(GamePlayer_SearchTraceTest, ReadRejectsOtherFiles)
+{
+    std::vector<SearchTrace::Event> events;
+    EXPECT_FALSE(SearchTrace::read(testing::TempDir() + "does-not-exist.gptr", &events));
+}
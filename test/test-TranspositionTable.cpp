@@ -0,0 +1,97 @@
+#include "GamePlayer/TranspositionTable.h"
+
+#include "gtest/gtest.h"
+
+using namespace GamePlayer;
+
+TEST(GamePlayer_TranspositionTableTest, SizeFromMemoryBudget)
+{
+    // The number of entries is rounded down to a power of two
+    TranspositionTable tt(MemoryBudget{3 << 20}, 4);
+    EXPECT_EQ(tt.size(), size_t(1) << 17);
+    EXPECT_LE(tt.bytes(), size_t(3) << 20);
+
+    // There is always at least one entry
+    TranspositionTable tiny(MemoryBudget{1}, 4);
+    EXPECT_EQ(tiny.size(), 1u);
+}
+
+TEST(GamePlayer_TranspositionTableTest, ResizeKeepsEntries)
+{
+    TranspositionTable tt(1024, 4);
+    for (uint64_t fp = 1; fp <= 100; ++fp)
+    {
+        tt.set(fp * 0x9e3779b97f4a7c15ULL, (float)fp, 1);
+    }
+
+    tt.resize(4096);
+    EXPECT_EQ(tt.size(), 4096u);
+    int found = 0;
+    for (uint64_t fp = 1; fp <= 100; ++fp)
+    {
+        auto result = tt.check(fp * 0x9e3779b97f4a7c15ULL);
+        if (result)
+        {
+            EXPECT_EQ(result->first, (float)fp);
+            ++found;
+        }
+    }
+    EXPECT_GT(found, 90); // A few may have been lost to collisions in the original table
+
+    tt.resize(MemoryBudget{1 << 16}, false);
+    EXPECT_EQ(tt.size(), 4096u);
+    EXPECT_EQ(tt.occupancy(tt.size()), 0.0f);
+}
+
+TEST(GamePlayer_TranspositionTableTest, ResizeKeepsTheHigherQuality)
+{
+    // Both fingerprints map to the same slot in a table of 4 entries, but not in a table of 8
+    TranspositionTable tt(8, 4);
+    tt.set(1, 1.0f, 2);
+    tt.set(5, 5.0f, 3);
+
+    tt.resize(4);
+    EXPECT_FALSE(tt.check(1));
+    ASSERT_TRUE(tt.check(5));
+    EXPECT_EQ(tt.check(5)->first, 5.0f);
+}
+
+TEST(GamePlayer_TranspositionTableTest, ClearAndOccupancy)
+{
+    // The table is large enough to be cleared by more than one thread
+    TranspositionTable tt(MemoryBudget{32 << 20}, 4);
+    EXPECT_EQ(tt.occupancy(), 0.0f);
+
+    // Fill the first half of the table
+    for (uint64_t i = 0; i < tt.size() / 2; ++i)
+    {
+        tt.set(i, 0.0f, 0);
+    }
+    EXPECT_EQ(tt.occupancy(tt.size()), 0.5f);
+    EXPECT_NEAR(tt.occupancy(100), 0.5f, 0.1f);
+
+    tt.clear(4);
+    EXPECT_EQ(tt.occupancy(tt.size()), 0.0f);
+    EXPECT_FALSE(tt.check(2));
+}
+
+TEST(GamePlayer_TranspositionTableTest, ResizeToTheSameSizeOrToZero)
+{
+    TranspositionTable tt(16, 4);
+    tt.set(3, 3.0f, 1);
+
+    tt.resize(16);
+    ASSERT_TRUE(tt.check(3));
+
+    // A table always has at least one entry
+    tt.resize(0);
+    EXPECT_EQ(tt.size(), 1u);
+    ASSERT_TRUE(tt.check(3));
+    EXPECT_EQ(tt.check(3)->first, 3.0f);
+
+    // So does a table constructed with no entries
+    TranspositionTable empty(0, 4);
+    EXPECT_EQ(empty.size(), 1u);
+    empty.set(3, 3.0f, 1);
+    EXPECT_TRUE(empty.check(3));
+}
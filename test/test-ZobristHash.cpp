@@ -0,0 +1,100 @@
+#include "GamePlayer/GameState.h"
+#include "GamePlayer/ZobristHash.h"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <set>
+
+using namespace GamePlayer;
+
+namespace
+{
+using Hash = ZobristHash<9, 2>;
+
+// The keys are available at compile time
+static_assert(Hash::key(0, 0) != Hash::key(1, 0), "keys should differ");
+static_assert(Hash::toggle(Hash::toggle(0, 1, 4), 1, 4) == 0, "toggling twice should restore the hash");
+
+// A board that counts how many times its fingerprint is computed
+class CountingState : public GameState
+{
+public:
+    CountingState() { board.fill(Hash::EMPTY); }
+
+    uint64_t fingerprint() const override
+    {
+        ++computeCount;
+        return Hash::compute([this](size_t square) { return board[square]; }, false);
+    }
+
+    PlayerId whoseTurn() const override { return PlayerId::ALICE; }
+
+    std::array<int, 9> board;
+    mutable int        computeCount = 0;
+};
+} // anonymous namespace
+
+TEST(GamePlayer_ZobristHashTest, KeysAreDistinct)
+{
+    std::set<uint64_t> keys;
+    for (int piece = 0; piece < 2; ++piece)
+    {
+        for (size_t square = 0; square < 9; ++square)
+            keys.insert(Hash::key(piece, square));
+    }
+    keys.insert(Hash::turnKey());
+    EXPECT_EQ(keys.size(), 19u);
+    EXPECT_EQ(keys.count(0), 0u);
+}
+
+TEST(GamePlayer_ZobristHashTest, DifferentSeedsGiveDifferentKeys)
+{
+    EXPECT_NE((ZobristHash<9, 2, 1>::key(0, 0)), (ZobristHash<9, 2, 2>::key(0, 0)));
+}
+
+TEST(GamePlayer_ZobristHashTest, IncrementalUpdateMatchesFullComputation)
+{
+    std::array<int, 9> board;
+    board.fill(Hash::EMPTY);
+    auto     pieceAt = [&board](size_t square) { return board[square]; };
+    uint64_t hash    = Hash::compute(pieceAt, false);
+
+    // Place a piece, then move it, changing the turn each time
+    board[4] = 0;
+    hash     = Hash::toggleTurn(Hash::toggle(hash, 0, 4));
+    EXPECT_EQ(hash, Hash::compute(pieceAt, true));
+
+    board[4] = Hash::EMPTY;
+    board[8] = 0;
+    hash     = Hash::toggleTurn(Hash::move(hash, 0, 4, 8));
+    EXPECT_EQ(hash, Hash::compute(pieceAt, false));
+}
+
+TEST(GamePlayer_ZobristHashTest, FingerprintIsCached)
+{
+    CountingState state;
+    state.board[2]  = 1;
+    uint64_t first  = state.cachedFingerprint();
+    uint64_t second = state.cachedFingerprint();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(state.computeCount, 1);
+
+    // A copy does not inherit the cache because it is usually modified
+    CountingState copy(state);
+    copy.computeCount = 0;
+    copy.board[3]     = 0;
+    EXPECT_NE(copy.cachedFingerprint(), first);
+    EXPECT_EQ(copy.computeCount, 1);
+
+    // A fingerprint set by an incremental update is used as is
+    copy.board[5] = 1;
+    copy.setCachedFingerprint(Hash::toggle(copy.cachedFingerprint(), 1, 5));
+    EXPECT_EQ(copy.cachedFingerprint(), copy.fingerprint());
+    EXPECT_EQ(copy.computeCount, 2); // Only the explicit call to fingerprint()
+
+    state.board[2] = Hash::EMPTY;
+    state.invalidateCachedFingerprint();
+    EXPECT_NE(state.cachedFingerprint(), first);
+    EXPECT_EQ(state.computeCount, 2);
+}
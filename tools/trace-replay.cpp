@@ -0,0 +1,227 @@
+// Replays a search trace recorded by GameTree and prints statistics about the search.
+//
+// For each ply, the number of states searched or evaluated, the number of cutoffs and other outcomes, the average number of
+// responses searched, and the time spent are reported. The inclusive time of a state includes the time spent searching its
+// responses and the exclusive time does not. A leaf is a response whose preliminary value was computed without a search (by the
+// static evaluator or from the transposition table). Every response is a leaf first, so a response that is later searched is
+// counted twice.
+//
+// Usage: GamePlayer_trace-replay [--json] <trace file>
+
+#include "GamePlayer/SearchTrace.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <vector>
+
+using namespace GamePlayer;
+using json = nlohmann::json;
+
+namespace
+{
+struct DepthStatistics
+{
+    long     nodes           = 0; // Number of states whose search or evaluation ended at this ply
+    long     leaves          = 0; // Number of states evaluated without a search
+    long     ttHits          = 0; // Number of leaves whose values were found in the transposition table
+    long     alphaCutoffs    = 0;
+    long     betaCutoffs     = 0;
+    long     databaseHits    = 0;
+    long     nullMoveCutoffs = 0;
+    long     noResponses     = 0;
+    long     children        = 0; // Number of responses searched (not counting leaves)
+    uint64_t inclusiveTime   = 0; // Nanoseconds
+    uint64_t exclusiveTime   = 0; // Nanoseconds
+    uint64_t maxTime         = 0; // Longest search of a single state, in nanoseconds
+};
+
+// A state whose search has begun but not ended
+struct OpenState
+{
+    SearchTrace::Event enter;
+    uint64_t           childTime = 0; // Total inclusive time of the responses
+    long               children  = 0; // Number of responses searched
+};
+
+struct Statistics
+{
+    std::vector<DepthStatistics> depths;
+    long                         events    = 0;
+    long                         unmatched = 0; // Events without a matching event (e.g., lost when a ring buffer wrapped)
+    size_t                       distinct  = 0; // Number of distinct states searched
+    uint64_t                     duration  = 0; // Time between the first and last events, in nanoseconds
+};
+
+Statistics replay(std::vector<SearchTrace::Event> const & events)
+{
+    Statistics             statistics;
+    std::vector<OpenState> stack;
+    std::set<uint64_t>     fingerprints;
+
+    statistics.events = (long)events.size();
+    if (!events.empty())
+        statistics.duration = events.back().time - events.front().time;
+
+    for (auto const & event : events)
+    {
+        if (statistics.depths.size() <= event.depth)
+            statistics.depths.resize(event.depth + 1);
+
+        if (!(event.flags & SearchTrace::EXIT))
+        {
+            if (!stack.empty() && !(event.flags & SearchTrace::LEAF))
+                ++stack.back().children;
+            stack.push_back(OpenState{event});
+            continue;
+        }
+
+        // Find the matching enter event. Anything above it was never closed.
+        auto match = std::find_if(stack.rbegin(),
+                                  stack.rend(),
+                                  [&event](OpenState const & s)
+                                  { return s.enter.fingerprint == event.fingerprint && s.enter.depth == event.depth; });
+        if (match == stack.rend())
+        {
+            ++statistics.unmatched;
+            continue;
+        }
+        size_t index = stack.size() - 1 - (size_t)(match - stack.rbegin());
+        statistics.unmatched += (long)(stack.size() - 1 - index);
+        OpenState state = stack[index];
+        stack.resize(index);
+
+        DepthStatistics & d         = statistics.depths[event.depth];
+        uint64_t          inclusive = event.time - state.enter.time;
+        ++d.nodes;
+        d.leaves += (event.flags & SearchTrace::LEAF) ? 1 : 0;
+        d.ttHits += (event.flags & SearchTrace::TT_HIT) ? 1 : 0;
+        d.alphaCutoffs += (event.flags & SearchTrace::ALPHA_CUTOFF) ? 1 : 0;
+        d.betaCutoffs += (event.flags & SearchTrace::BETA_CUTOFF) ? 1 : 0;
+        d.databaseHits += (event.flags & SearchTrace::DATABASE_HIT) ? 1 : 0;
+        d.nullMoveCutoffs += (event.flags & SearchTrace::NULL_MOVE_CUTOFF) ? 1 : 0;
+        d.noResponses += (event.flags & SearchTrace::NO_RESPONSES) ? 1 : 0;
+        d.children += state.children;
+        d.inclusiveTime += inclusive;
+        d.exclusiveTime += inclusive - std::min(inclusive, state.childTime);
+        d.maxTime = std::max(d.maxTime, inclusive);
+        fingerprints.insert(event.fingerprint);
+
+        if (!stack.empty())
+            stack.back().childTime += inclusive;
+    }
+
+    statistics.unmatched += (long)stack.size();
+    statistics.distinct = fingerprints.size();
+    return statistics;
+}
+
+json toJson(Statistics const & statistics)
+{
+    json depths = json::array();
+    for (auto const & d : statistics.depths)
+    {
+        depths.push_back({{"nodes", d.nodes},
+                          {"leaves", d.leaves},
+                          {"ttHits", d.ttHits},
+                          {"alphaCutoffs", d.alphaCutoffs},
+                          {"betaCutoffs", d.betaCutoffs},
+                          {"databaseHits", d.databaseHits},
+                          {"nullMoveCutoffs", d.nullMoveCutoffs},
+                          {"noResponses", d.noResponses},
+                          {"children", d.children},
+                          {"inclusiveTime", d.inclusiveTime},
+                          {"exclusiveTime", d.exclusiveTime},
+                          {"maxTime", d.maxTime}});
+    }
+    return json{{"events", statistics.events},
+                {"unmatched", statistics.unmatched},
+                {"distinct", statistics.distinct},
+                {"duration", statistics.duration},
+                {"depths", depths}};
+}
+
+void print(Statistics const & statistics)
+{
+    printf("events = %ld, unmatched = %ld, distinct states = %zu, duration = %.3f ms\n\n",
+           statistics.events,
+           statistics.unmatched,
+           statistics.distinct,
+           statistics.duration * 1e-6);
+    printf("%5s %10s %10s %9s %9s %9s %9s %9s %9s %9s %12s %12s %10s %10s\n",
+           "depth",
+           "nodes",
+           "leaves",
+           "tt hits",
+           "alpha",
+           "beta",
+           "database",
+           "null",
+           "terminal",
+           "children",
+           "incl ms",
+           "excl ms",
+           "excl %",
+           "max us");
+
+    uint64_t total = 0;
+    for (auto const & d : statistics.depths)
+        total += d.exclusiveTime;
+
+    for (size_t depth = 0; depth < statistics.depths.size(); ++depth)
+    {
+        DepthStatistics const & d = statistics.depths[depth];
+        printf("%5zu %10ld %10ld %9ld %9ld %9ld %9ld %9ld %9ld %9.2f %12.3f %12.3f %9.1f%% %10.1f\n",
+               depth,
+               d.nodes,
+               d.leaves,
+               d.ttHits,
+               d.alphaCutoffs,
+               d.betaCutoffs,
+               d.databaseHits,
+               d.nullMoveCutoffs,
+               d.noResponses,
+               (d.nodes > d.leaves) ? (double)d.children / (double)(d.nodes - d.leaves) : 0.0,
+               d.inclusiveTime * 1e-6,
+               d.exclusiveTime * 1e-6,
+               total ? 100.0 * (double)d.exclusiveTime / (double)total : 0.0,
+               d.maxTime * 1e-3);
+    }
+}
+} // anonymous namespace
+
+int main(int argc, char ** argv)
+{
+    bool         asJson = false;
+    char const * path   = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--json") == 0)
+            asJson = true;
+        else
+            path = argv[i];
+    }
+    if (!path)
+    {
+        fprintf(stderr, "usage: %s [--json] <trace file>\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<SearchTrace::Event> events;
+    if (!SearchTrace::read(path, &events))
+    {
+        fprintf(stderr, "%s: unable to read trace file '%s'\n", argv[0], path);
+        return 1;
+    }
+
+    Statistics statistics = replay(events);
+    if (asJson)
+        printf("%s\n", toJson(statistics).dump(2).c_str());
+    else
+        print(statistics);
+    return 0;
+}